@@ -12,7 +12,7 @@ const std::vector<std::string> CodeEditor::keywords_ = {
 };
 
 const std::vector<std::string> CodeEditor::types_ = {
-    "Tensor", "TensorDB", "Shape", "DataType"
+    "Tensor", "TensorDB", "SparseTensor", "Shape", "DataType"
 };
 
 const std::vector<std::string> CodeEditor::tensorMethods_ = {
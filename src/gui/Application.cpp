@@ -276,7 +276,9 @@ void Application::renderDatabase() {
 
         DrawText(names[i].c_str(), static_cast<int>(itemBounds.x + 10), static_cast<int>(itemBounds.y + 8), 18, Colors::TEXT);
         if (meta) {
-            DrawText(meta->shapeString().c_str(), static_cast<int>(itemBounds.x + 10),
+            std::string label = meta->shapeString();
+            if (meta->sparse) label += " sparse, nnz " + std::to_string(meta->nnz);
+            DrawText(label.c_str(), static_cast<int>(itemBounds.x + 10),
                      static_cast<int>(itemBounds.y + 28), 14, Colors::TEXT_DIM);
         }
 
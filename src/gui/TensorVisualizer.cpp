@@ -1,7 +1,9 @@
 #include "gui/TensorVisualizer.hpp"
+#include "tensor/NdIterator.hpp"
 #include "rlgl.h"
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace gui {
 
@@ -19,9 +21,15 @@ void TensorVisualizer::setTensor(const tensor::Tensor& t) {
 }
 
 void TensorVisualizer::setTensor(const tensor::Tensor& t, const std::string& name) {
-    tensor_ = t;
+    // Gleiche Version heißt gleicher Inhalt: Normalisierung nicht wiederholen
+    bool unchanged = tensor_ && t.version() == sourceVersion_ && normalizedValues_.size() == t.size();
+    sourceVersion_ = t.version();
+
+    // Zusammenhängend in float32 ablegen: die Zeichenmodi laufen per
+    // NdIterator in derselben flachen Reihenfolge wie normalizedValues_
+    tensor_ = t.to(tensor::DType::Float32).contiguous();
     tensorName_ = name;
-    normalizedValues_ = t.normalizedData();
+    if (!unchanged) normalizedValues_ = t.normalizedData();
     elementAnimations_.resize(t.size(), 0.0f);
 
     // Kamera anpassen
@@ -35,6 +43,7 @@ void TensorVisualizer::setTensor(const tensor::Tensor& t, const std::string& nam
 
 void TensorVisualizer::clearTensor() {
     tensor_.reset();
+    sourceVersion_ = 0;
     tensorName_.clear();
     normalizedValues_.clear();
     elementAnimations_.clear();
@@ -204,19 +213,11 @@ void TensorVisualizer::highlightElement(const std::vector<size_t>& indices) {
 
 void TensorVisualizer::highlightSlice(size_t axis, size_t index) {
     highlightedIndices_.clear();
-    if (!tensor_) return;
+    if (!tensor_ || tensor_->empty()) return;
 
     // Alle Elemente mit dem gegebenen Index auf der Achse highlighten
-    for (size_t i = 0; i < tensor_->size(); ++i) {
-        // Berechne Indizes aus flachem Index (vereinfacht)
-        auto indices = std::vector<size_t>();
-        size_t remaining = i;
-        for (size_t d = 0; d < tensor_->rank(); ++d) {
-            size_t stride = tensor_->strides()[d];
-            indices.push_back(remaining / stride);
-            remaining %= stride;
-        }
-
+    for (tensor::NdIterator<> it(tensor_->shape()); !it.done(); it.next()) {
+        const auto& indices = it.index();
         if (axis < indices.size() && indices[axis] == index) {
             highlightedIndices_.insert(highlightedIndices_.end(), indices.begin(), indices.end());
         }
@@ -246,7 +247,7 @@ BoundingBox TensorVisualizer::getBoundingBox() const {
 }
 
 void TensorVisualizer::drawCubesMode() {
-    if (!tensor_) return;
+    if (!tensor_ || tensor_->empty()) return;
 
     const auto& shape = tensor_->shape();
     Vector3 offset = {0, 0, 0};
@@ -256,15 +257,9 @@ void TensorVisualizer::drawCubesMode() {
     if (shape.size() >= 2) offset.y = -(shape[1] - 1) * spacing_ / 2;
     if (shape.size() >= 3) offset.z = -(shape[2] - 1) * spacing_ / 2;
 
-    for (size_t i = 0; i < tensor_->size(); ++i) {
-        // Indizes berechnen
-        std::vector<size_t> indices;
-        size_t remaining = i;
-        for (size_t d = 0; d < tensor_->rank(); ++d) {
-            size_t stride = tensor_->strides()[d];
-            indices.push_back(remaining / stride);
-            remaining %= stride;
-        }
+    for (tensor::NdIterator<> it(shape); !it.done(); it.next()) {
+        size_t i = it.flat();
+        const auto& indices = it.index();
 
         Vector3 pos = getElementPosition(indices);
         pos.x += offset.x;
@@ -310,7 +305,7 @@ void TensorVisualizer::drawCubesMode() {
 }
 
 void TensorVisualizer::drawSpheresMode() {
-    if (!tensor_) return;
+    if (!tensor_ || tensor_->empty()) return;
 
     const auto& shape = tensor_->shape();
     Vector3 offset = {0, 0, 0};
@@ -319,14 +314,9 @@ void TensorVisualizer::drawSpheresMode() {
     if (shape.size() >= 2) offset.y = -(shape[1] - 1) * spacing_ / 2;
     if (shape.size() >= 3) offset.z = -(shape[2] - 1) * spacing_ / 2;
 
-    for (size_t i = 0; i < tensor_->size(); ++i) {
-        std::vector<size_t> indices;
-        size_t remaining = i;
-        for (size_t d = 0; d < tensor_->rank(); ++d) {
-            size_t stride = tensor_->strides()[d];
-            indices.push_back(remaining / stride);
-            remaining %= stride;
-        }
+    for (tensor::NdIterator<> it(shape); !it.done(); it.next()) {
+        size_t i = it.flat();
+        const auto& indices = it.index();
 
         Vector3 pos = getElementPosition(indices);
         pos.x += offset.x;
@@ -350,7 +340,7 @@ void TensorVisualizer::drawSpheresMode() {
 }
 
 void TensorVisualizer::drawPointsMode() {
-    if (!tensor_) return;
+    if (!tensor_ || tensor_->empty()) return;
 
     const auto& shape = tensor_->shape();
     Vector3 offset = {0, 0, 0};
@@ -359,14 +349,9 @@ void TensorVisualizer::drawPointsMode() {
     if (shape.size() >= 2) offset.y = -(shape[1] - 1) * spacing_ / 2;
     if (shape.size() >= 3) offset.z = -(shape[2] - 1) * spacing_ / 2;
 
-    for (size_t i = 0; i < tensor_->size(); ++i) {
-        std::vector<size_t> indices;
-        size_t remaining = i;
-        for (size_t d = 0; d < tensor_->rank(); ++d) {
-            size_t stride = tensor_->strides()[d];
-            indices.push_back(remaining / stride);
-            remaining %= stride;
-        }
+    for (tensor::NdIterator<> it(shape); !it.done(); it.next()) {
+        size_t i = it.flat();
+        const auto& indices = it.index();
 
         Vector3 pos = getElementPosition(indices);
         pos.x += offset.x;
@@ -391,7 +376,7 @@ void TensorVisualizer::drawHeatmapMode() {
 
     for (size_t i = 0; i < shape[0]; ++i) {
         for (size_t j = 0; j < shape[1]; ++j) {
-            float value = tensor_->at(i, j);
+            float value = std::as_const(*tensor_)(i, j);
             size_t idx = i * shape[1] + j;
             Color color = getElementColor(normalizedValues_[idx], false);
 
@@ -419,7 +404,7 @@ void TensorVisualizer::drawBarsMode() {
     Vector3 offset = {-(n - 1) * barWidth * 1.2f / 2, 0, 0};
 
     for (size_t i = 0; i < n; ++i) {
-        float value = (*tensor_)[i];
+        float value = std::as_const(*tensor_)[i];
         Color color = getElementColor(normalizedValues_[i], false);
 
         float anim = std::min(1.0f, entryAnimation_ * 3.0f - static_cast<float>(i) / n * 2.0f);
@@ -434,7 +419,7 @@ void TensorVisualizer::drawBarsMode() {
 }
 
 void TensorVisualizer::drawNetworkMode() {
-    if (!tensor_) return;
+    if (!tensor_ || tensor_->empty()) return;
 
     // Verbindungen zwischen benachbarten Elementen zeichnen
     const auto& shape = tensor_->shape();
@@ -445,14 +430,8 @@ void TensorVisualizer::drawNetworkMode() {
     if (shape.size() >= 3) offset.z = -(shape[2] - 1) * spacing_ / 2;
 
     // Erst Linien
-    for (size_t i = 0; i < tensor_->size(); ++i) {
-        std::vector<size_t> indices;
-        size_t remaining = i;
-        for (size_t d = 0; d < tensor_->rank(); ++d) {
-            size_t stride = tensor_->strides()[d];
-            indices.push_back(remaining / stride);
-            remaining %= stride;
-        }
+    for (tensor::NdIterator<> it(shape); !it.done(); it.next()) {
+        const auto& indices = it.index();
 
         Vector3 pos = getElementPosition(indices);
         pos.x += offset.x;
@@ -462,7 +441,7 @@ void TensorVisualizer::drawNetworkMode() {
         // Verbindungen zu Nachbarn
         for (size_t d = 0; d < indices.size(); ++d) {
             if (indices[d] + 1 < shape[d]) {
-                std::vector<size_t> neighborIdx = indices;
+                tensor::Shape neighborIdx = indices;
                 neighborIdx[d]++;
                 Vector3 neighborPos = getElementPosition(neighborIdx);
                 neighborPos.x += offset.x;
@@ -475,14 +454,9 @@ void TensorVisualizer::drawNetworkMode() {
     }
 
     // Dann Knoten
-    for (size_t i = 0; i < tensor_->size(); ++i) {
-        std::vector<size_t> indices;
-        size_t remaining = i;
-        for (size_t d = 0; d < tensor_->rank(); ++d) {
-            size_t stride = tensor_->strides()[d];
-            indices.push_back(remaining / stride);
-            remaining %= stride;
-        }
+    for (tensor::NdIterator<> it(shape); !it.done(); it.next()) {
+        size_t i = it.flat();
+        const auto& indices = it.index();
 
         Vector3 pos = getElementPosition(indices);
         pos.x += offset.x;
@@ -582,7 +556,7 @@ void TensorVisualizer::drawAxes() {
     // (würde 3D-Text erfordern, hier vereinfacht weggelassen)
 }
 
-Vector3 TensorVisualizer::getElementPosition(const std::vector<size_t>& indices) const {
+Vector3 TensorVisualizer::getElementPosition(const tensor::Shape& indices) const {
     Vector3 pos = {0, 0, 0};
     if (indices.size() >= 1) pos.x = indices[0] * spacing_;
     if (indices.size() >= 2) pos.y = indices[1] * spacing_;
@@ -604,7 +578,7 @@ Color TensorVisualizer::getElementColor(float normalizedValue, bool highlighted)
 }
 
 void TensorVisualizer::updateSelection() {
-    if (!tensor_) {
+    if (!tensor_ || tensor_->empty()) {
         selected_.valid = false;
         return;
     }
@@ -623,14 +597,9 @@ void TensorVisualizer::updateSelection() {
     if (shape.size() >= 2) offset.y = -(shape[1] - 1) * spacing_ / 2;
     if (shape.size() >= 3) offset.z = -(shape[2] - 1) * spacing_ / 2;
 
-    for (size_t i = 0; i < tensor_->size(); ++i) {
-        std::vector<size_t> indices;
-        size_t remaining = i;
-        for (size_t d = 0; d < tensor_->rank(); ++d) {
-            size_t stride = tensor_->strides()[d];
-            indices.push_back(remaining / stride);
-            remaining %= stride;
-        }
+    for (tensor::NdIterator<> it(shape); !it.done(); it.next()) {
+        size_t i = it.flat();
+        const auto& indices = it.index();
 
         Vector3 pos = getElementPosition(indices);
         pos.x += offset.x;
@@ -646,7 +615,7 @@ void TensorVisualizer::updateSelection() {
         if (collision.hit && collision.distance < closestDist) {
             closestDist = collision.distance;
             selected_.indices = indices;
-            selected_.value = (*tensor_)[i];
+            selected_.value = std::as_const(*tensor_)[i];
             selected_.worldPosition = pos;
             selected_.valid = true;
         }
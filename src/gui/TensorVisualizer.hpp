@@ -26,7 +26,7 @@ enum class VisualizationMode {
  * @brief Informationen über ein ausgewähltes Element
  */
 struct SelectedElement {
-    std::vector<size_t> indices;
+    tensor::Shape indices;
     float value;
     Vector3 worldPosition;
     bool valid = false;
@@ -83,6 +83,7 @@ public:
 private:
     // Tensor-Daten
     std::optional<tensor::Tensor> tensor_;
+    uint64_t sourceVersion_ = 0;  // version() des übergebenen Tensors
     std::string tensorName_;
     std::vector<float> normalizedValues_;
 
@@ -123,9 +124,9 @@ private:
 
     void drawGrid();
     void drawAxes();
-    void drawElementInfo(Vector3 pos, const std::vector<size_t>& indices, float value);
+    void drawElementInfo(Vector3 pos, const tensor::Shape& indices, float value);
 
-    Vector3 getElementPosition(const std::vector<size_t>& indices) const;
+    Vector3 getElementPosition(const tensor::Shape& indices) const;
     Color getElementColor(float normalizedValue, bool highlighted = false) const;
 
     void updateSelection();
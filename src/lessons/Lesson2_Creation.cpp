@@ -57,7 +57,14 @@ void Lesson2_Creation::init() {
         "// Zufaellig [-1, 1]\n"
         "auto r2 = Tensor::random({4,4}, -1.0f, 1.0f);\n"
         "\n"
-        "// Jeder Aufruf gibt andere Werte!",
+        "// Jeder Aufruf gibt andere Werte!\n"
+        "\n"
+        "// Normalverteilt (Mittel 0, Std 1)\n"
+        "auto r3 = Tensor::randn({4, 4});\n"
+        "\n"
+        "// Reproduzierbar: gleicher Seed,\n"
+        "// gleiche Werte\n"
+        "tensor::manualSeed(42);",
         []() { return tensor::Tensor::random({5, 5}); },
         gui::VisualizationMode::Heatmap
     });
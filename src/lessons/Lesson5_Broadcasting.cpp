@@ -49,7 +49,7 @@ public:
             []() {
                 auto a = tensor::Tensor::ones({3, 4});
                 auto b = tensor::Tensor::range(1, 5);
-                return a;  // Visualisiere die Matrix
+                return a + b;  // (3, 4) + (4) -> (3, 4)
             },
             gui::VisualizationMode::Heatmap
         });
@@ -91,7 +91,8 @@ public:
             "Tensor result = matrix + vec;  // 3x4",
             []() {
                 auto matrix = tensor::Tensor::ones({3, 4});
-                return matrix;
+                auto vec = tensor::Tensor::range(1, 5);
+                return matrix + vec;
             },
             gui::VisualizationMode::Heatmap
         });
@@ -112,14 +113,9 @@ public:
             "//  [2*1, 2*2, 2*3, 2*4],\n"
             "//  [3*1, 3*2, 3*3, 3*4]]",
             []() {
-                // Simuliere Outer Product
-                auto result = tensor::Tensor({3, 4});
-                for (size_t i = 0; i < 3; ++i) {
-                    for (size_t j = 0; j < 4; ++j) {
-                        result.at(i, j) = (i + 1) * (j + 1);
-                    }
-                }
-                return result;
+                tensor::Tensor a({3, 1}, {1, 2, 3});
+                tensor::Tensor b({1, 4}, {1, 2, 3, 4});
+                return a * b;
             },
             gui::VisualizationMode::Heatmap
         });
@@ -202,7 +198,7 @@ public:
             "// Analog für Standardabweichung",
             []() {
                 auto data = tensor::Tensor::random({5, 4});
-                return data;
+                return data - data.mean(0);
             },
             gui::VisualizationMode::Heatmap
         });
@@ -1,4 +1,6 @@
 #include "lessons/Lesson.hpp"
+#include "tensor/Conv.hpp"
+#include "tensor/NN.hpp"
 
 namespace lessons {
 
@@ -109,18 +111,17 @@ public:
             "// Wichtige Aktivierungen:\n"
             "\n"
             "// ReLU: max(0, x)\n"
-            "auto relu = z.apply([](float x) {\n"
-            "    return x > 0 ? x : 0;\n"
-            "});\n"
+            "Tensor a = z.relu();\n"
             "\n"
             "// Sigmoid: 1 / (1 + e^-x)\n"
-            "auto sigmoid = (-z).exp();\n"
-            "sigmoid = Tensor::ones(z.shape()) / \n"
-            "          (Tensor::ones(z.shape()) + sigmoid);",
+            "Tensor s = z.sigmoid();\n"
+            "\n"
+            "// Auch tanh() und gelu(); alle lazy:\n"
+            "Tensor h = (x.matmul(W) + b).relu();",
             []() {
                 // ReLU Visualisierung
                 auto input = tensor::Tensor::random({5, 5}, -1.0f, 1.0f);
-                return input.apply([](float x) { return x > 0 ? x : 0; });
+                return tensor::Tensor(input.relu());
             },
             gui::VisualizationMode::Heatmap
         });
@@ -142,14 +143,16 @@ public:
             "    }\n"
             "    \n"
             "    Tensor forward(const Tensor& x) {\n"
-            "        auto z = x.matmul(weights) + bias;\n"
-            "        return relu(z);\n"
+            "        // matmul, Bias und ReLU in einem Schritt\n"
+            "        return linear(x, weights, bias,\n"
+            "                      Activation::ReLU);\n"
             "    }\n"
             "};",
             []() {
                 auto input = tensor::Tensor::random({4, 4});
                 auto weights = tensor::Tensor::random({4, 3});
-                return input.matmul(weights);
+                auto bias = tensor::Tensor::fill({3}, 0.1f);
+                return tensor::linear(input, weights, bias, tensor::Activation::ReLU);
             },
             gui::VisualizationMode::Heatmap
         });
@@ -178,26 +181,30 @@ public:
             gui::VisualizationMode::Network
         });
 
-        // Schritt 8: Convolutional Layer Konzept
+        // Schritt 8: Convolutional Layer
         addStep({
-            "Convolution (Konzept)",
+            "Convolution",
             "CNNs für Bilder nutzen lokale Filter statt volle Verbindungen.\n\n"
             "Ein Filter 'gleitet' über das Bild.\n"
             "Tensor-Shape: (batch, channels, height, width)",
             "// CNN Tensor Shapes\n"
-            "Tensor image({1, 3, 28, 28});  // RGB Bild\n"
-            "Tensor filter({16, 3, 3, 3});  // 16 Filter 3x3\n"
+            "Tensor image = Tensor::random({1, 3, 28, 28});  // RGB Bild\n"
+            "Tensor filter = Tensor::random({16, 3, 3, 3});  // 16 Filter 3x3\n"
             "\n"
-            "// Nach Convolution:\n"
+            "Tensor features = conv2d(image, filter);\n"
             "// Output: (1, 16, 26, 26)\n"
             "// - 16 Feature Maps\n"
             "// - Größe reduziert durch Filter\n"
             "\n"
-            "// Kernoperationen sind immer noch\n"
-            "// Tensor-Multiplikationen!",
+            "Tensor pooled = maxPool2d(features, 2);\n"
+            "// Output: (1, 16, 13, 13)\n"
+            "\n"
+            "// Intern: im2col + Matrixmultiplikation!",
             []() {
-                // Simuliere Feature Map
-                return tensor::Tensor::random({4, 4});
+                // Kantenfilter (Sobel) auf einem Zufallsbild
+                auto image = tensor::Tensor::random({1, 1, 6, 6});
+                auto edge = tensor::Tensor({1, 1, 3, 3}, {-1, 0, 1, -2, 0, 2, -1, 0, 1});
+                return tensor::conv2d(image, edge).reshape({4, 4});
             },
             gui::VisualizationMode::Heatmap
         });
@@ -251,6 +258,9 @@ public:
             "dW = x.T @ dh            // Gradient\n"
             "W = W - lr * dW          // Update\n"
             "\n"
+            "// Automatisch mit autograd::Tape:\n"
+            "tape.backward(loss)      // dW -> W.grad\n"
+            "\n"
             "// Alles sind Tensor-Operationen!",
             []() {
                 return tensor::Tensor::random({5, 5, 5});
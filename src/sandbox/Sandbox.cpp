@@ -1,4 +1,5 @@
 #include "sandbox/Sandbox.hpp"
+#include "tensor/Allocator.hpp"
 #include <sstream>
 #include <algorithm>
 
@@ -240,7 +241,9 @@ void Sandbox::renderControlPanel() {
             auto meta = storage_.getMetadata(name);
             DrawText(name.c_str(), static_cast<int>(contentX + 10), static_cast<int>(contentY + 5), 16, gui::Colors::TEXT);
             if (meta) {
-                DrawText(meta->shapeString().c_str(), static_cast<int>(contentX + 10), static_cast<int>(contentY + 22), 12, gui::Colors::TEXT_DIM);
+                std::string label = meta->shapeString();
+                if (meta->sparse) label += " sparse, nnz " + std::to_string(meta->nnz);
+                DrawText(label.c_str(), static_cast<int>(contentX + 10), static_cast<int>(contentY + 22), 12, gui::Colors::TEXT_DIM);
             }
 
             // Laden-Button
@@ -288,8 +291,9 @@ void Sandbox::renderTensorInfo() {
     DrawText(TextFormat("Rang: %zu | Elemente: %zu", currentTensor_.rank(), currentTensor_.size()), static_cast<int>(infoX + 10), static_cast<int>(infoY + 55), 14, gui::Colors::TEXT_DIM);
 
     if (!currentTensor_.empty()) {
-        DrawText(TextFormat("Min: %.2f | Max: %.2f | Mean: %.2f",
-            currentTensor_.min(), currentTensor_.max(), currentTensor_.mean()),
+        // Jeden Frame: stats() ist bis zur nächsten Änderung zwischengespeichert
+        auto stats = currentTensor_.stats();
+        DrawText(TextFormat("Min: %.2f | Max: %.2f | Mean: %.2f", stats.min, stats.max, stats.mean),
             static_cast<int>(infoX + 10), static_cast<int>(infoY + 75), 12, gui::Colors::TEXT_DIM);
     }
 }
@@ -451,14 +455,29 @@ std::string Sandbox::parseAndExecute(const std::string& cmd) {
     try {
         if (command == "help") {
             return "Befehle: zeros(shape), ones(shape), random(shape), range(start,end), identity(n), "
-                   "+n, -n, *n, /n, transpose, flatten, sqrt, abs, normalize, info";
+                   "+n, -n, *n, /n, transpose, flatten, sqrt, abs, normalize, info, memory";
         }
         else if (command == "info") {
             if (!hasTensor_) return "Kein Tensor geladen";
-            return "Shape: " + currentTensor_.shapeString() +
-                   " | Elemente: " + std::to_string(currentTensor_.size()) +
-                   " | Min: " + std::to_string(currentTensor_.min()) +
-                   " | Max: " + std::to_string(currentTensor_.max());
+            auto stats = currentTensor_.stats();
+            std::string info = "Shape: " + currentTensor_.shapeString() +
+                               " | Elemente: " + std::to_string(currentTensor_.size()) +
+                               " | Typ: " + tensor::dtypeName(currentTensor_.dtype()) +
+                               " | Min: " + std::to_string(stats.min) +
+                               " | Max: " + std::to_string(stats.max) +
+                               " | Mean: " + std::to_string(stats.mean);
+            if (stats.nanCount || stats.infCount) {
+                info += " | NaN: " + std::to_string(stats.nanCount) +
+                        " | Inf: " + std::to_string(stats.infCount);
+            }
+            return info;
+        }
+        else if (command == "memory") {
+            auto stats = tensor::Allocator::instance().stats();
+            return "Puffer: " + std::to_string(stats.bytesInUse / 1024) + " KiB belegt" +
+                   " | " + std::to_string(stats.bytesCached / 1024) + " KiB im Cache" +
+                   " | Treffer: " + std::to_string(stats.hits) +
+                   " | Neu: " + std::to_string(stats.misses);
         }
         else if (command == "zeros" || command == "ones" || command == "random") {
             std::string shapeStr;
@@ -0,0 +1,254 @@
+#include "tensor/Allocator.hpp"
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace tensor {
+
+namespace {
+
+// Klassen bis 1 MiB werden pro Thread gehalten, je höchstens 8 Puffer
+constexpr size_t THREAD_MAX_SHIFT = 20;
+constexpr size_t THREAD_MAX_BLOCKS = 8;
+
+size_t defaultCacheLimit() {
+    if (const char* env = std::getenv("TENSOR_CACHE_MB")) {
+        char* end = nullptr;
+        long mb = std::strtol(env, &end, 10);
+        if (end != env && mb >= 0) return static_cast<size_t>(mb) << 20;
+    }
+    return size_t(1) << 30;
+}
+
+void addAtomic(std::atomic<size_t>& counter, size_t value) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+void subAtomic(std::atomic<size_t>& counter, size_t value) {
+    counter.fetch_sub(value, std::memory_order_relaxed);
+}
+
+// Bleibt nach dem Abbau des Thread-Caches lesbar (trivial zerstörbar)
+thread_local bool threadCacheGone = false;
+
+} // namespace
+
+// === Cache pro Thread ===
+
+struct Allocator::ThreadCache {
+    std::vector<void*> blocks[THREAD_MAX_SHIFT - MIN_SHIFT + 1];
+
+    // Beim Thread-Ende in den gemeinsamen Cache (oder ans System) zurück
+    ~ThreadCache() {
+        release();
+        threadCacheGone = true;
+    }
+
+    void release() {
+        Allocator& a = instance();
+        for (size_t i = 0; i < sizeof(blocks) / sizeof(blocks[0]); ++i) {
+            for (void* p : blocks[i]) {
+                subAtomic(a.bytesCached_, classBytes(i));
+                if (a.pushShared(i, p)) {
+                    addAtomic(a.bytesCached_, classBytes(i));
+                } else {
+                    a.systemFree(p, classBytes(i));
+                }
+            }
+            blocks[i].clear();
+        }
+    }
+};
+
+Allocator::ThreadCache* Allocator::threadCache() {
+    if (threadCacheGone) return nullptr;
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+// === Allocator ===
+
+Allocator& Allocator::instance() {
+    // Absichtlich nie zerstört: Puffer statischer Tensoren und Thread-Caches
+    // werden noch beim Programmende zurückgegeben
+    static Allocator* allocator = new Allocator();
+    return *allocator;
+}
+
+Allocator::Allocator() : cacheLimit_(defaultCacheLimit()) {}
+
+size_t Allocator::classIndex(size_t bytes) {
+    size_t shift = MIN_SHIFT;
+    while ((size_t(1) << shift) < bytes) ++shift;
+    return shift - MIN_SHIFT;
+}
+
+void* Allocator::allocate(size_t bytes) {
+    if (bytes == 0) return nullptr;
+
+    // Jenseits der größten Klasse direkt und ohne Cache
+    bool cached = bytes <= classBytes(CLASS_COUNT - 1);
+    size_t index = cached ? classIndex(bytes) : 0;
+    size_t size = cached ? classBytes(index) : bytes;
+    void* ptr = nullptr;
+
+    if (cached && index + MIN_SHIFT <= THREAD_MAX_SHIFT) {
+        if (ThreadCache* local = threadCache()) {
+            if (!local->blocks[index].empty()) {
+                ptr = local->blocks[index].back();
+                local->blocks[index].pop_back();
+            }
+        }
+    }
+    if (cached && !ptr) ptr = popShared(index);
+
+    if (ptr) {
+        addAtomic(hits_, 1);
+        subAtomic(bytesCached_, size);
+    } else {
+        addAtomic(misses_, 1);
+        ptr = systemAllocate(size);
+    }
+
+    size_t inUse = bytesInUse_.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peakBytesInUse_.load(std::memory_order_relaxed);
+    while (inUse > peak && !peakBytesInUse_.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {}
+    return ptr;
+}
+
+void Allocator::deallocate(void* ptr, size_t bytes) {
+    if (!ptr) return;
+
+    if (bytes > classBytes(CLASS_COUNT - 1)) {
+        subAtomic(bytesInUse_, bytes);
+        systemFree(ptr, bytes);
+        return;
+    }
+
+    size_t index = classIndex(bytes);
+    size_t size = classBytes(index);
+    subAtomic(bytesInUse_, size);
+
+    if (cacheLimit() == 0) {
+        systemFree(ptr, size);
+        return;
+    }
+    if (index + MIN_SHIFT <= THREAD_MAX_SHIFT) {
+        ThreadCache* local = threadCache();
+        if (local && local->blocks[index].size() < THREAD_MAX_BLOCKS) {
+            local->blocks[index].push_back(ptr);
+            addAtomic(bytesCached_, size);
+            return;
+        }
+    }
+    if (pushShared(index, ptr)) {
+        addAtomic(bytesCached_, size);
+    } else {
+        systemFree(ptr, size);
+    }
+}
+
+void Allocator::setCacheLimit(size_t bytes) {
+    cacheLimit_.store(bytes, std::memory_order_relaxed);
+    if (bytes == 0) {
+        trim();
+        return;
+    }
+    // Überhang abbauen, größte Klassen zuerst
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = CLASS_COUNT; i-- > 0 && bytesCached_.load(std::memory_order_relaxed) > bytes;) {
+        while (!shared_[i].empty() && bytesCached_.load(std::memory_order_relaxed) > bytes) {
+            systemFree(shared_[i].back(), classBytes(i));
+            shared_[i].pop_back();
+            subAtomic(bytesCached_, classBytes(i));
+        }
+    }
+}
+
+void Allocator::trim() {
+    if (ThreadCache* local = threadCache()) {
+        for (size_t i = 0; i < sizeof(local->blocks) / sizeof(local->blocks[0]); ++i) {
+            for (void* p : local->blocks[i]) {
+                systemFree(p, classBytes(i));
+                subAtomic(bytesCached_, classBytes(i));
+            }
+            local->blocks[i].clear();
+        }
+    }
+    trimShared();
+}
+
+Allocator::Stats Allocator::stats() const {
+    Stats s;
+    s.hits = hits_.load(std::memory_order_relaxed);
+    s.misses = misses_.load(std::memory_order_relaxed);
+    s.bytesInUse = bytesInUse_.load(std::memory_order_relaxed);
+    s.peakBytesInUse = peakBytesInUse_.load(std::memory_order_relaxed);
+    s.bytesCached = bytesCached_.load(std::memory_order_relaxed);
+    s.hugePageBytes = hugePageBytes_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void Allocator::resetStats() {
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    hugePageBytes_.store(0, std::memory_order_relaxed);
+    peakBytesInUse_.store(bytesInUse_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+// === Private Hilfsmethoden ===
+
+void* Allocator::systemAllocate(size_t bytes) {
+    size_t alignment = alignmentFor(bytes);
+    void* ptr = ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+    if (!ptr) {
+        // Speicher knapp: gecachte Puffer freigeben und einmal neu versuchen
+        trim();
+        ptr = ::operator new(bytes, std::align_val_t(alignment));
+    }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (alignment == HUGE_PAGE_SIZE && hugePages()) {
+        // Nur ein Hinweis an den Kernel; Fehler (z.B. THP aus) sind harmlos
+        if (madvise(ptr, bytes & ~(HUGE_PAGE_SIZE - 1), MADV_HUGEPAGE) == 0) {
+            addAtomic(hugePageBytes_, bytes);
+        }
+    }
+#endif
+    return ptr;
+}
+
+void Allocator::systemFree(void* ptr, size_t bytes) {
+    ::operator delete(ptr, std::align_val_t(alignmentFor(bytes)));
+}
+
+bool Allocator::pushShared(size_t index, void* ptr) {
+    size_t size = classBytes(index);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytesCached_.load(std::memory_order_relaxed) + size > cacheLimit()) return false;
+    shared_[index].push_back(ptr);
+    return true;
+}
+
+void* Allocator::popShared(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shared_[index].empty()) return nullptr;
+    void* ptr = shared_[index].back();
+    shared_[index].pop_back();
+    return ptr;
+}
+
+void Allocator::trimShared() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < CLASS_COUNT; ++i) {
+        for (void* p : shared_[i]) {
+            systemFree(p, classBytes(i));
+            subAtomic(bytesCached_, classBytes(i));
+        }
+        shared_[i].clear();
+    }
+}
+
+} // namespace tensor
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace tensor {
+
+/**
+ * @brief Caching-Allokator für Tensor-Puffer
+ *
+ * Schleifen wie W -= lr * dW oder die Befehlsketten im Sandbox erzeugen
+ * ständig gleich große Puffer und geben sie sofort wieder frei. Statt
+ * jedes Mal den Heap (und bei großen Puffern neue Seitenfehler) zu
+ * bemühen, werden freigegebene Puffer nach Größenklasse (Zweierpotenzen
+ * von 64 Byte bis 64 MiB) aufbewahrt und wiederverwendet. Größere Puffer
+ * gehen in exakter Größe direkt ans System.
+ *
+ * Kleine Klassen liegen zuerst in einem Cache pro Thread (ohne Sperre),
+ * Überlauf und große Klassen in einem gemeinsamen Cache mit Byte-Limit.
+ * Alle Puffer sind auf 64 Byte ausgerichtet; Puffer ab 2 MiB auf 2 MiB
+ * und unter Linux optional mit Transparent Huge Pages hinterlegt.
+ *
+ * Der Inhalt wiederverwendeter Puffer ist undefiniert.
+ */
+class Allocator {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    struct Stats {
+        size_t hits = 0;           // aus einem Cache bedient
+        size_t misses = 0;         // neu vom System geholt
+        size_t bytesInUse = 0;     // ausgegeben (gerundet auf Größenklassen, falls gecacht)
+        size_t peakBytesInUse = 0;
+        size_t bytesCached = 0;    // freigegeben, aber aufbewahrt
+        size_t hugePageBytes = 0;  // seit resetStats() mit Huge Pages angefordert
+    };
+
+    static Allocator& instance();
+
+    Allocator(const Allocator&) = delete;
+    Allocator& operator=(const Allocator&) = delete;
+
+    // Mindestens bytes Bytes; bytes muss bei deallocate gleich sein
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr, size_t bytes);
+
+    // Obergrenze für gecachte Bytes (gemeinsamer Cache); 0 schaltet das
+    // Caching ab. Standard: 1 GiB oder TENSOR_CACHE_MB
+    void setCacheLimit(size_t bytes);
+    size_t cacheLimit() const { return cacheLimit_.load(std::memory_order_relaxed); }
+
+    // Huge Pages für neue große Puffer (nur Linux, Standard: an)
+    void setHugePages(bool enabled) { hugePages_.store(enabled, std::memory_order_relaxed); }
+    bool hugePages() const { return hugePages_.load(std::memory_order_relaxed); }
+
+    // Gibt den gemeinsamen Cache und den des aufrufenden Threads frei
+    void trim();
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    Allocator();
+
+    struct ThreadCache;
+    // nullptr, wenn der Cache des Threads schon abgebaut ist (Programmende)
+    static ThreadCache* threadCache();
+
+    static constexpr size_t MIN_SHIFT = 6;    // 64 Byte
+    // 64 MiB; größere Puffer exakt und ohne Cache, damit das Aufrunden auf
+    // Zweierpotenzen große Tensoren nicht bis zu doppelt so viel kostet
+    static constexpr size_t MAX_SHIFT = 26;
+    static constexpr size_t CLASS_COUNT = MAX_SHIFT - MIN_SHIFT + 1;
+
+    static size_t classIndex(size_t bytes);
+    static size_t classBytes(size_t index) { return size_t(1) << (index + MIN_SHIFT); }
+    static size_t alignmentFor(size_t bytes) { return bytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : ALIGNMENT; }
+
+    void* systemAllocate(size_t bytes);
+    void systemFree(void* ptr, size_t bytes);
+
+    // Gemeinsamer Cache; false, wenn das Limit überschritten wäre
+    bool pushShared(size_t index, void* ptr);
+    void* popShared(size_t index);
+    void trimShared();
+
+    std::mutex mutex_;
+    std::vector<void*> shared_[CLASS_COUNT];
+
+    std::atomic<size_t> cacheLimit_;
+    std::atomic<bool> hugePages_{true};
+
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    std::atomic<size_t> bytesInUse_{0};
+    std::atomic<size_t> peakBytesInUse_{0};
+    std::atomic<size_t> bytesCached_{0};
+    std::atomic<size_t> hugePageBytes_{0};
+};
+
+} // namespace tensor
@@ -0,0 +1,468 @@
+#include "tensor/Autograd.hpp"
+#include "tensor/Gemm.hpp"
+#include "tensor/Reduce.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace tensor {
+namespace autograd {
+
+enum class Op : uint8_t {
+    Leaf,
+    Add,
+    Sub,
+    Mul,
+    Matmul,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Gelu,
+    Linear,
+    Sum,
+    Mean,
+    Mse,
+    SoftmaxCrossEntropy
+};
+
+struct Tape::Node {
+    Op op = Op::Leaf;
+    Activation activation = Activation::None;
+    bool requiresGrad = false;
+    uint8_t inputCount = 0;
+    uint32_t inputs[3] = {};
+    Parameter* param = nullptr;
+    Tensor value;   // float32, zusammenhängend
+    Tensor grad;    // leer, bis ein Verbraucher beiträgt
+    Tensor saved;   // Zwischenergebnis für backward (z.B. Softmax)
+
+    void clear() {
+        value = Tensor();
+        grad = Tensor();
+        saved = Tensor();
+        param = nullptr;
+    }
+};
+
+namespace {
+
+Tensor f32(const Tensor& t) {
+    return t.to(DType::Float32).contiguous();
+}
+
+// Gradient eines gebroadcasteten Operanden: über die verbreiterten Achsen summieren
+Tensor sumToShape(const Tensor& g, const Shape& shape) {
+    if (g.shape() == shape) return g;
+    size_t lead = g.rank() - shape.size();
+    std::vector<size_t> axes;
+    for (size_t d = 0; d < g.rank(); ++d) {
+        if (d < lead || (shape[d - lead] == 1 && g.shape()[d] != 1)) axes.push_back(d);
+    }
+    return g.sum(axes).reshape(shape);
+}
+
+// g *= f'(.) für Aktivierungen; y ist die Ausgabe, z die Eingabe (nur GELU)
+void activationBackward(Activation activation, float* g, const float* y, const float* z, size_t n) {
+    switch (activation) {
+        case Activation::ReLU:
+            for (size_t i = 0; i < n; ++i) g[i] = y[i] > 0.0f ? g[i] : 0.0f;
+            break;
+        case Activation::Sigmoid:
+            for (size_t i = 0; i < n; ++i) g[i] *= y[i] * (1.0f - y[i]);
+            break;
+        case Activation::Tanh:
+            for (size_t i = 0; i < n; ++i) g[i] *= 1.0f - y[i] * y[i];
+            break;
+        case Activation::GELU: {
+            // d/dz 0.5 z (1 + tanh(u)), u = c (z + 0.044715 z^3)
+            constexpr float c = 0.7978845608f;
+            for (size_t i = 0; i < n; ++i) {
+                float x = z[i];
+                float t = std::tanh(c * (x + 0.044715f * x * x * x));
+                float du = c * (1.0f + 3.0f * 0.044715f * x * x);
+                g[i] *= 0.5f * (1.0f + t) + 0.5f * x * (1.0f - t * t) * du;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Lesezugriff ohne detach(): Werte teilen den Speicher z.B. mit Parameter::value
+const float* cdata(const Tensor& t) {
+    return t.data();
+}
+
+float scalar(const Tensor& t) {
+    return cdata(t)[0];
+}
+
+Tensor scalarTensor(float v) {
+    return Tensor(Shape{1}, std::vector<float>{v});
+}
+
+} // namespace
+
+// === Parameter / Var ===
+
+Parameter::Parameter(const Tensor& initial)
+    : value(f32(initial)), grad(initial.shape()) {}
+
+void Parameter::zeroGrad() {
+    if (grad.shape() != value.shape() || !grad.isContiguous()) {
+        grad = Tensor(value.shape());
+        return;
+    }
+    float* g = grad.data();
+    std::fill(g, g + grad.size(), 0.0f);
+}
+
+const Tensor& Var::value() const {
+    if (!tape_) throw std::invalid_argument("Var is not bound to a tape");
+    return tape_->value(*this);
+}
+
+// === Tape ===
+
+Tape::Tape() = default;
+Tape::~Tape() = default;
+
+Tape::Node& Tape::node(uint32_t id) const {
+    return chunks_[id / CHUNK_SIZE][id % CHUNK_SIZE];
+}
+
+Tape::Node& Tape::allocate() {
+    if (count_ == capacity()) {
+        chunks_.push_back(std::make_unique<Node[]>(CHUNK_SIZE));
+    }
+    Node& n = node(static_cast<uint32_t>(count_++));
+    n.op = Op::Leaf;
+    n.activation = Activation::None;
+    n.requiresGrad = false;
+    n.inputCount = 0;
+    return n;
+}
+
+void Tape::check(const Var& v) const {
+    if (v.tape() != this || v.id() >= count_) {
+        throw std::invalid_argument("Var belongs to a different tape or was reset");
+    }
+    if (released_) {
+        throw std::invalid_argument("Tape values were released by backward(); call reset() first");
+    }
+}
+
+const Tensor& Tape::value(const Var& v) const {
+    if (v.tape() != this || v.id() >= count_) {
+        throw std::invalid_argument("Var belongs to a different tape or was reset");
+    }
+    return node(v.id()).value;
+}
+
+Var Tape::constant(const Tensor& value) {
+    if (released_) {
+        throw std::invalid_argument("Tape values were released by backward(); call reset() first");
+    }
+    Node& n = allocate();
+    n.value = f32(value);
+    return Var(this, static_cast<uint32_t>(count_ - 1));
+}
+
+Var Tape::param(Parameter& p) {
+    if (released_) {
+        throw std::invalid_argument("Tape values were released by backward(); call reset() first");
+    }
+    if (p.grad.shape() != p.value.shape() || !p.grad.isContiguous() ||
+        p.grad.dtype() != DType::Float32) {
+        p.grad = Tensor(p.value.shape());
+    }
+    Node& n = allocate();
+    n.value = f32(p.value);
+    n.param = &p;
+    n.requiresGrad = true;
+    return Var(this, static_cast<uint32_t>(count_ - 1));
+}
+
+void Tape::reset() {
+    for (size_t i = 0; i < count_; ++i) node(static_cast<uint32_t>(i)).clear();
+    count_ = 0;
+    released_ = false;
+}
+
+// === Aufzeichnung und Rückwärtslauf ===
+
+struct Ops {
+    static Tape& tapeOf(std::initializer_list<const Var*> vars) {
+        Tape* tape = nullptr;
+        for (const Var* v : vars) {
+            if (!v->valid()) continue;
+            if (!tape) tape = v->tape();
+            tape->check(*v);
+        }
+        if (!tape) throw std::invalid_argument("Operation needs at least one Var on a tape");
+        return *tape;
+    }
+
+    static const Tensor& in(Tape& t, const Var& v) { return t.node(v.id()).value; }
+
+    static Var record(Tape& t, Op op, std::initializer_list<const Var*> inputs, Tensor value,
+                      Activation activation = Activation::None, Tensor saved = Tensor()) {
+        Tape::Node& n = t.allocate();
+        n.op = op;
+        n.activation = activation;
+        for (const Var* v : inputs) {
+            if (!v->valid()) continue;
+            n.inputs[n.inputCount++] = v->id();
+            n.requiresGrad = n.requiresGrad || t.node(v->id()).requiresGrad;
+        }
+        n.value = f32(value);
+        n.saved = std::move(saved);
+        return Var(&t, static_cast<uint32_t>(t.count_ - 1));
+    }
+
+    // Zielpuffer des Gradienten (Parameter: dessen grad), ggf. mit Nullen angelegt
+    static Tensor& gradBuffer(Tape::Node& n) {
+        Tensor& dst = n.param ? n.param->grad : n.grad;
+        if (dst.empty()) dst = Tensor(n.value.shape());
+        return dst;
+    }
+
+    static void accumulate(Tape::Node& n, const Tensor& g) {
+        if (!n.requiresGrad) return;
+        Tensor contribution = sumToShape(g, n.value.shape());
+        Tensor& dst = n.param ? n.param->grad : n.grad;
+        if (dst.empty()) {
+            dst = f32(contribution);
+        } else {
+            dst += contribution;
+        }
+    }
+
+    // C += A * B über die GEMM direkt in den Gradientenpuffer
+    static void accumulateProduct(Tape::Node& n, size_t m, size_t cols, size_t k,
+                                  const float* a, size_t rsA, size_t csA,
+                                  const float* b, size_t rsB, size_t csB) {
+        if (!n.requiresGrad) return;
+        Tensor& dst = gradBuffer(n);
+        gemm::sgemm(m, cols, k, a, rsA, csA, b, rsB, csB, dst.data(), cols, true);
+    }
+
+    static void backwardNode(Tape& t, Tape::Node& n) {
+        const Tensor g = n.grad;
+        Tape::Node* in0 = n.inputCount > 0 ? &t.node(n.inputs[0]) : nullptr;
+        Tape::Node* in1 = n.inputCount > 1 ? &t.node(n.inputs[1]) : nullptr;
+        Tape::Node* in2 = n.inputCount > 2 ? &t.node(n.inputs[2]) : nullptr;
+
+        switch (n.op) {
+            case Op::Leaf:
+                break;
+            case Op::Add:
+                accumulate(*in0, g);
+                accumulate(*in1, g);
+                break;
+            case Op::Sub:
+                accumulate(*in0, g);
+                if (in1->requiresGrad) accumulate(*in1, Tensor(-g));
+                break;
+            case Op::Mul:
+                if (in0->requiresGrad) accumulate(*in0, Tensor(g * in1->value));
+                if (in1->requiresGrad) accumulate(*in1, Tensor(g * in0->value));
+                break;
+            case Op::Matmul: {
+                // a (m, k), b (k, n): dA += dC b^T, dB += a^T dC
+                size_t m = in0->value.shape()[0];
+                size_t k = in0->value.shape()[1];
+                size_t cols = in1->value.shape()[1];
+                const float* gd = cdata(g);
+                const float* a = cdata(in0->value);
+                const float* b = cdata(in1->value);
+                accumulateProduct(*in0, m, k, cols, gd, cols, 1, b, 1, cols);
+                accumulateProduct(*in1, k, cols, m, a, 1, k, gd, cols, 1);
+                break;
+            }
+            case Op::Relu:
+            case Op::Sigmoid:
+            case Op::Tanh:
+            case Op::Gelu: {
+                Tensor dz = g.contiguous();
+                float* d = dz.data();  // g ist mit n.grad geteilt: kopiert beim Schreiben
+                activationBackward(n.activation, d, cdata(n.value), cdata(in0->value), dz.size());
+                accumulate(*in0, dz);
+                break;
+            }
+            case Op::Linear: {
+                const Tensor& x = in0->value;
+                const Tensor& w = in1->value;
+                size_t inF = w.shape()[0];
+                size_t outF = w.shape()[1];
+                size_t rows = x.size() / inF;
+
+                Tensor dz = g.contiguous();
+                float* d = dz.data();
+                const float* z = n.saved.empty() ? nullptr : cdata(n.saved);
+                activationBackward(n.activation, d, cdata(n.value), z, dz.size());
+
+                // dx += dz W^T, dW += x^T dz, db += Spaltensummen von dz
+                accumulateProduct(*in0, rows, inF, outF, d, outF, 1, cdata(w), 1, outF);
+                accumulateProduct(*in1, inF, outF, rows, cdata(x), 1, inF, d, outF, 1);
+                if (in2 && in2->requiresGrad) {
+                    Tensor db(Shape{outF});
+                    reduce::axis(reduce::Op::Sum, d, db.data(), 1, rows, outF);
+                    accumulate(*in2, db);
+                }
+                break;
+            }
+            case Op::Sum:
+                accumulate(*in0, Tensor::fill(in0->value.shape(), scalar(g)));
+                break;
+            case Op::Mean:
+                accumulate(*in0, Tensor::fill(in0->value.shape(),
+                                              scalar(g) / static_cast<float>(in0->value.size())));
+                break;
+            case Op::Mse: {
+                // saved = prediction - target
+                float scale = 2.0f * scalar(g) / static_cast<float>(n.saved.size());
+                if (in0->requiresGrad) accumulate(*in0, Tensor(n.saved * scale));
+                if (in1->requiresGrad) accumulate(*in1, Tensor(n.saved * -scale));
+                break;
+            }
+            case Op::SoftmaxCrossEntropy: {
+                // saved = softmax(logits); dL/dlogits = (p - t) / rows
+                // (äußeres Tensor(...): autograd::operator* verdeckt die Ausdrucks-Operatoren)
+                const Tensor& target = in1->value;
+                float scale = scalar(g) / static_cast<float>(n.saved.size() / n.saved.shape().back());
+                if (in0->requiresGrad) accumulate(*in0, Tensor(Tensor(n.saved - target) * scale));
+                if (in1->requiresGrad) accumulate(*in1, Tensor(Tensor(n.saved.log()) * -scale));
+                break;
+            }
+        }
+    }
+};
+
+void Tape::backward(const Var& loss) {
+    check(loss);
+    Node& root = node(loss.id());
+    if (root.value.size() != 1) {
+        throw std::invalid_argument("backward expects a scalar loss, got " + root.value.shapeString());
+    }
+    if (!root.requiresGrad) return;
+
+    root.grad = scalarTensor(1.0f);
+    for (size_t i = loss.id() + 1; i-- > 0;) {
+        Node& n = node(static_cast<uint32_t>(i));
+        if (n.requiresGrad && !n.param && !n.grad.empty()) Ops::backwardNode(*this, n);
+        // Alle Verbraucher von i liegen dahinter und sind fertig
+        if (i != loss.id()) {
+            n.value = Tensor();
+            n.saved = Tensor();
+        }
+        n.grad = Tensor();
+    }
+    released_ = true;
+}
+
+// === Operationen ===
+
+Var operator+(const Var& a, const Var& b) {
+    Tape& t = Ops::tapeOf({&a, &b});
+    return Ops::record(t, Op::Add, {&a, &b}, Ops::in(t, a) + Ops::in(t, b));
+}
+
+Var operator-(const Var& a, const Var& b) {
+    Tape& t = Ops::tapeOf({&a, &b});
+    return Ops::record(t, Op::Sub, {&a, &b}, Ops::in(t, a) - Ops::in(t, b));
+}
+
+Var operator*(const Var& a, const Var& b) {
+    Tape& t = Ops::tapeOf({&a, &b});
+    return Ops::record(t, Op::Mul, {&a, &b}, Ops::in(t, a) * Ops::in(t, b));
+}
+
+Var matmul(const Var& a, const Var& b) {
+    Tape& t = Ops::tapeOf({&a, &b});
+    const Tensor& x = Ops::in(t, a);
+    const Tensor& y = Ops::in(t, b);
+    if (x.rank() != 2 || y.rank() != 2) {
+        throw std::invalid_argument("autograd::matmul expects 2D operands, got " +
+                                    x.shapeString() + " and " + y.shapeString());
+    }
+    return Ops::record(t, Op::Matmul, {&a, &b}, x.matmul(y));
+}
+
+Var relu(const Var& x) {
+    Tape& t = Ops::tapeOf({&x});
+    return Ops::record(t, Op::Relu, {&x}, Ops::in(t, x).relu(), Activation::ReLU);
+}
+
+Var sigmoid(const Var& x) {
+    Tape& t = Ops::tapeOf({&x});
+    return Ops::record(t, Op::Sigmoid, {&x}, Ops::in(t, x).sigmoid(), Activation::Sigmoid);
+}
+
+Var tanh(const Var& x) {
+    Tape& t = Ops::tapeOf({&x});
+    return Ops::record(t, Op::Tanh, {&x}, Ops::in(t, x).tanh(), Activation::Tanh);
+}
+
+Var gelu(const Var& x) {
+    Tape& t = Ops::tapeOf({&x});
+    return Ops::record(t, Op::Gelu, {&x}, Ops::in(t, x).gelu(), Activation::GELU);
+}
+
+Var linear(const Var& x, const Var& weight, const Var& bias, Activation activation) {
+    Tape& t = Ops::tapeOf({&x, &weight, &bias});
+    const Tensor& xv = Ops::in(t, x);
+    const Tensor& wv = Ops::in(t, weight);
+    const Tensor bv = bias.valid() ? Ops::in(t, bias) : Tensor();
+    if (activation == Activation::GELU) {
+        // Ableitung braucht die Voraktivierung
+        Tensor z = tensor::linear(xv, wv, bv);
+        Tensor y = z.gelu();
+        return Ops::record(t, Op::Linear, {&x, &weight, &bias}, y, activation, z);
+    }
+    return Ops::record(t, Op::Linear, {&x, &weight, &bias},
+                       tensor::linear(xv, wv, bv, activation), activation);
+}
+
+Var sum(const Var& x) {
+    Tape& t = Ops::tapeOf({&x});
+    return Ops::record(t, Op::Sum, {&x}, scalarTensor(Ops::in(t, x).sum()));
+}
+
+Var mean(const Var& x) {
+    Tape& t = Ops::tapeOf({&x});
+    return Ops::record(t, Op::Mean, {&x}, scalarTensor(Ops::in(t, x).mean()));
+}
+
+Var mse(const Var& prediction, const Var& target) {
+    Tape& t = Ops::tapeOf({&prediction, &target});
+    const Tensor& p = Ops::in(t, prediction);
+    const Tensor& y = Ops::in(t, target);
+    if (p.shape() != y.shape()) {
+        throw std::invalid_argument("mse: prediction " + p.shapeString() +
+                                    " and target " + y.shapeString() + " differ");
+    }
+    Tensor diff = p - y;
+    float loss = Tensor(diff * diff).mean();
+    return Ops::record(t, Op::Mse, {&prediction, &target}, scalarTensor(loss),
+                       Activation::None, diff);
+}
+
+Var softmaxCrossEntropy(const Var& logits, const Var& target) {
+    Tape& t = Ops::tapeOf({&logits, &target});
+    const Tensor& z = Ops::in(t, logits);
+    const Tensor& y = Ops::in(t, target);
+    if (z.rank() == 0 || z.shape() != y.shape()) {
+        throw std::invalid_argument("softmaxCrossEntropy: logits " + z.shapeString() +
+                                    " and target " + y.shapeString() + " differ");
+    }
+    size_t rows = z.size() / z.shape().back();
+    float loss = -Tensor(y * logSoftmax(z)).sum() / static_cast<float>(rows);
+    return Ops::record(t, Op::SoftmaxCrossEntropy, {&logits, &target}, scalarTensor(loss),
+                       Activation::None, softmax(z));
+}
+
+} // namespace autograd
+} // namespace tensor
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "tensor/NN.hpp"
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+namespace autograd {
+
+class Tape;
+
+/**
+ * @brief Trainierbarer Tensor mit eigenem Gradientenpuffer
+ *
+ * grad wird einmal angelegt (float32, Form von value) und von
+ * Tape::backward() in-place aufaddiert; zeroGrad() setzt ihn vor dem
+ * nächsten Schritt zurück, ohne neu zu allokieren.
+ */
+struct Parameter {
+    Tensor value;
+    Tensor grad;
+
+    Parameter() = default;
+    explicit Parameter(const Tensor& initial);
+
+    void zeroGrad();
+};
+
+/**
+ * @brief Handle auf einen Knoten des Bands
+ *
+ * Klein und kopierbar; gültig bis zum nächsten Tape::reset().
+ */
+class Var {
+public:
+    Var() = default;
+
+    bool valid() const { return tape_ != nullptr; }
+    Tape* tape() const { return tape_; }
+    uint32_t id() const { return id_; }
+
+    // Wert des Knotens; Zwischenwerte sind nach backward() freigegeben
+    const Tensor& value() const;
+    const Shape& shape() const { return value().shape(); }
+
+private:
+    friend class Tape;
+    friend struct Ops;
+    Var(Tape* tape, uint32_t id) : tape_(tape), id_(id) {}
+
+    Tape* tape_ = nullptr;
+    uint32_t id_ = 0;
+};
+
+/**
+ * @brief Band für Reverse-Mode-Autodiff (opt-in neben Tensor)
+ *
+ * Operationen auf Var werden vorwärts sofort ausgewertet und als Knoten
+ * aufgezeichnet. backward(loss) läuft die Knoten rückwärts ab und
+ * akkumuliert in die Gradientenpuffer der Parameter; Matrixprodukte
+ * schreiben dabei per GEMM direkt in den Puffer (C += A * B).
+ *
+ * Die Knoten liegen in einer Arena aus festen Blöcken: reset() verwirft
+ * nur den Inhalt, die Blöcke bleiben für den nächsten Schritt erhalten.
+ * Da Knoten in Erzeugungsreihenfolge liegen, sind beim Rückwärtslauf an
+ * Knoten i alle Verbraucher schon fertig - Wert und Gradient von i
+ * werden direkt danach freigegeben (zurück an den Caching-Allokator).
+ *
+ * Nicht threadsicher; ein Band pro Thread bzw. Trainingsschleife.
+ */
+class Tape {
+public:
+    Tape();
+    ~Tape();
+
+    Tape(const Tape&) = delete;
+    Tape& operator=(const Tape&) = delete;
+
+    // Eingabe ohne Gradient (Daten, Labels)
+    Var constant(const Tensor& value);
+
+    // Parameter; p muss bis nach backward() leben
+    Var param(Parameter& p);
+
+    // loss muss ein Skalar (ein Element) sein
+    void backward(const Var& loss);
+
+    // Alle Knoten verwerfen, Arena behalten
+    void reset();
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return chunks_.size() * CHUNK_SIZE; }
+
+    const Tensor& value(const Var& v) const;
+
+    struct Node;
+
+private:
+    friend struct Ops;
+
+    static constexpr size_t CHUNK_SIZE = 256;
+
+    Node& node(uint32_t id) const;
+    Node& allocate();
+    void check(const Var& v) const;
+
+    std::vector<std::unique_ptr<Node[]>> chunks_;
+    size_t count_ = 0;
+    bool released_ = false;  // backward() lief, Zwischenwerte sind weg
+};
+
+// === Operationen (Broadcasting wie bei Tensor) ===
+
+Var operator+(const Var& a, const Var& b);
+Var operator-(const Var& a, const Var& b);
+Var operator*(const Var& a, const Var& b);
+
+// 2D: (m, k) @ (k, n)
+Var matmul(const Var& a, const Var& b);
+
+Var relu(const Var& x);
+Var sigmoid(const Var& x);
+Var tanh(const Var& x);
+Var gelu(const Var& x);
+
+// activation(x @ weight + bias) wie tensor::linear; bias darf ungültig sein
+Var linear(const Var& x, const Var& weight, const Var& bias = Var(),
+           Activation activation = Activation::None);
+
+// Skalare
+Var sum(const Var& x);
+Var mean(const Var& x);
+
+// Mittlerer quadratischer Fehler
+Var mse(const Var& prediction, const Var& target);
+
+// Mittlere Kreuzentropie über die Zeilen; target (n, classes) als
+// Wahrscheinlichkeiten (z.B. One-Hot), logits gleicher Form
+Var softmaxCrossEntropy(const Var& logits, const Var& target);
+
+} // namespace autograd
+} // namespace tensor
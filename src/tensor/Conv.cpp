@@ -0,0 +1,444 @@
+#include "tensor/Conv.hpp"
+#include "tensor/Gemm.hpp"
+#include "tensor/Scheduler.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tensor {
+
+namespace {
+
+// Direkter 3x3-Kernel bis zu so vielen Ein- und Ausgangskanälen pro
+// Gruppe (depthwise & Co.); darüber lohnt sich das Packen der GEMM,
+// schon ab einem RGB-Bild mit 32 Filtern ist sie mehrfach schneller
+constexpr size_t DIRECT_MAX_GROUP_CHANNELS = 2;
+
+// Layout-unabhängige Maße einer Faltung bzw. eines Poolings
+struct Geometry {
+    size_t batch = 0, channels = 0, height = 0, width = 0;
+    size_t kernelH = 1, kernelW = 1;
+    size_t strideH = 1, strideW = 1;
+    size_t padH = 0, padW = 0;
+    size_t dilationH = 1, dilationW = 1;
+    size_t outH = 0, outW = 0;
+
+    size_t inPixels() const { return height * width; }
+    size_t outPixels() const { return outH * outW; }
+};
+
+void readInput(const Tensor& input, Layout layout, Geometry& g, const char* op) {
+    if (input.rank() != 4) {
+        throw std::invalid_argument(std::string(op) + " expects a 4D input, got " + input.shapeString());
+    }
+    const Tensor::Shape& s = input.shape();
+    g.batch = s[0];
+    if (layout == Layout::NCHW) {
+        g.channels = s[1];
+        g.height = s[2];
+        g.width = s[3];
+    } else {
+        g.height = s[1];
+        g.width = s[2];
+        g.channels = s[3];
+    }
+}
+
+size_t outputExtent(size_t in, size_t kernel, size_t stride, size_t pad, size_t dilation,
+                    const char* op) {
+    size_t span = dilation * (kernel - 1) + 1;
+    if (in + 2 * pad < span) {
+        throw std::invalid_argument(std::string(op) + ": kernel larger than padded input");
+    }
+    return (in + 2 * pad - span) / stride + 1;
+}
+
+void computeOutput(Geometry& g, const char* op) {
+    g.outH = outputExtent(g.height, g.kernelH, g.strideH, g.padH, g.dilationH, op);
+    g.outW = outputExtent(g.width, g.kernelW, g.strideW, g.padW, g.dilationW, op);
+}
+
+Tensor::Shape outputShape(const Geometry& g, size_t channels, Layout layout) {
+    if (layout == Layout::NCHW) return {g.batch, channels, g.outH, g.outW};
+    return {g.batch, g.outH, g.outW, channels};
+}
+
+// Ausgabepositionen [lo, hi) einer Achse, deren Eingabeposition
+// o * stride + tap - pad im Bild [0, in) liegt
+void validRange(size_t tap, size_t pad, size_t stride, size_t in, size_t out,
+                size_t& lo, size_t& hi) {
+    lo = tap >= pad ? 0 : (pad - tap + stride - 1) / stride;
+    hi = pad + in > tap ? std::min(out, (pad + in - tap + stride - 1) / stride) : 0;
+    lo = std::min(lo, out);
+    hi = std::max(hi, lo);
+}
+
+// === im2col ===
+
+// NCHW: Spalte (K x P) mit K = (Kanal, kh, kw) für die Kanäle
+// [c0, c0 + cin) eines Bildes; jede Zeile ist ein verschobenes Bild
+void im2colNchw(const float* img, const Geometry& g, size_t c0, size_t cin, float* col) {
+    size_t taps = g.kernelH * g.kernelW;
+    size_t pixels = g.outPixels();
+    parallel_for(0, cin * taps, rowsPerTask(pixels), [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            size_t kh = (r % taps) / g.kernelW;
+            size_t kw = r % g.kernelW;
+            const float* plane = img + (c0 + r / taps) * g.inPixels();
+            size_t tapH = kh * g.dilationH, tapW = kw * g.dilationW;
+            size_t ohLo, ohHi, owLo, owHi;
+            validRange(tapH, g.padH, g.strideH, g.height, g.outH, ohLo, ohHi);
+            validRange(tapW, g.padW, g.strideW, g.width, g.outW, owLo, owHi);
+
+            float* dst = col + r * pixels;
+            std::fill(dst, dst + ohLo * g.outW, 0.0f);
+            for (size_t oh = ohLo; oh < ohHi; ++oh) {
+                const float* src = plane + (oh * g.strideH + tapH - g.padH) * g.width;
+                float* d = dst + oh * g.outW;
+                std::fill(d, d + owLo, 0.0f);
+                if (g.strideW == 1) {
+                    std::memcpy(d + owLo, src + owLo + tapW - g.padW, (owHi - owLo) * sizeof(float));
+                } else {
+                    for (size_t ow = owLo; ow < owHi; ++ow) d[ow] = src[ow * g.strideW + tapW - g.padW];
+                }
+                std::fill(d + owHi, d + g.outW, 0.0f);
+            }
+            std::fill(dst + ohHi * g.outW, dst + pixels, 0.0f);
+        }
+    });
+}
+
+// NHWC: Spalte (P x K) mit K = (kh, kw, Kanal); die Kanäle eines
+// Abgriffs werden am Stück kopiert
+void im2colNhwc(const float* img, const Geometry& g, size_t c0, size_t cin, float* col) {
+    size_t depth = g.kernelH * g.kernelW * cin;
+    parallel_for(0, g.outH, rowsPerTask(g.outW * depth), [&](size_t begin, size_t end) {
+        for (size_t oh = begin; oh < end; ++oh) {
+            for (size_t ow = 0; ow < g.outW; ++ow) {
+                float* d = col + (oh * g.outW + ow) * depth;
+                for (size_t kh = 0; kh < g.kernelH; ++kh) {
+                    size_t ih = oh * g.strideH + kh * g.dilationH;
+                    bool rowInside = ih >= g.padH && ih - g.padH < g.height;
+                    for (size_t kw = 0; kw < g.kernelW; ++kw, d += cin) {
+                        size_t iw = ow * g.strideW + kw * g.dilationW;
+                        if (!rowInside || iw < g.padW || iw - g.padW >= g.width) {
+                            std::fill(d, d + cin, 0.0f);
+                            continue;
+                        }
+                        const float* px = img + ((ih - g.padH) * g.width + iw - g.padW) * g.channels + c0;
+                        std::memcpy(d, px, cin * sizeof(float));
+                    }
+                }
+            }
+        }
+    });
+}
+
+// === Direkte 3x3-Kernel ===
+
+// NCHW: je Ausgabekanal wird für jeden Abgriff das verschobene
+// Eingabebild gewichtet aufaddiert (bei Stride 1 vektorisierbar)
+void direct3x3Nchw(const float* x, const float* w, float* out, const Geometry& g,
+                   size_t cout, size_t groups) {
+    size_t cinG = g.channels / groups;
+    size_t coutG = cout / groups;
+    size_t pixels = g.outPixels();
+    parallel_for(0, g.batch * cout, rowsPerTask(pixels * cinG * 9), [&](size_t begin, size_t end) {
+        for (size_t u = begin; u < end; ++u) {
+            size_t n = u / cout, oc = u % cout;
+            float* dst = out + u * pixels;
+            for (size_t ic = 0; ic < cinG; ++ic) {
+                const float* plane = x + (n * g.channels + (oc / coutG) * cinG + ic) * g.inPixels();
+                const float* wk = w + (oc * cinG + ic) * 9;
+                for (size_t tap = 0; tap < 9; ++tap) {
+                    float wv = wk[tap];
+                    size_t tapH = (tap / 3) * g.dilationH, tapW = (tap % 3) * g.dilationW;
+                    size_t ohLo, ohHi, owLo, owHi;
+                    validRange(tapH, g.padH, g.strideH, g.height, g.outH, ohLo, ohHi);
+                    validRange(tapW, g.padW, g.strideW, g.width, g.outW, owLo, owHi);
+                    for (size_t oh = ohLo; oh < ohHi; ++oh) {
+                        const float* src = plane + (oh * g.strideH + tapH - g.padH) * g.width;
+                        float* d = dst + oh * g.outW;
+                        if (g.strideW == 1) {
+                            const float* s = src + owLo + tapW - g.padW;
+                            for (size_t i = 0; i < owHi - owLo; ++i) d[owLo + i] += wv * s[i];
+                        } else {
+                            for (size_t ow = owLo; ow < owHi; ++ow) {
+                                d[ow] += wv * src[ow * g.strideW + tapW - g.padW];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+// NHWC: wr hat die Form (3, 3, cinG, cout); je Pixel und Abgriff wird
+// über die zusammenhängenden Ausgabekanäle akkumuliert
+void direct3x3Nhwc(const float* x, const float* wr, float* out, const Geometry& g,
+                   size_t cout, size_t groups) {
+    size_t cinG = g.channels / groups;
+    size_t coutG = cout / groups;
+    bool depthwise = cinG == 1 && coutG == 1;
+    parallel_for(0, g.batch * g.outH, rowsPerTask(g.outW * cout * cinG * 9), [&](size_t begin, size_t end) {
+        for (size_t u = begin; u < end; ++u) {
+            size_t n = u / g.outH, oh = u % g.outH;
+            for (size_t ow = 0; ow < g.outW; ++ow) {
+                float* d = out + (u * g.outW + ow) * cout;
+                for (size_t tap = 0; tap < 9; ++tap) {
+                    size_t ih = oh * g.strideH + (tap / 3) * g.dilationH;
+                    size_t iw = ow * g.strideW + (tap % 3) * g.dilationW;
+                    if (ih < g.padH || ih - g.padH >= g.height || iw < g.padW || iw - g.padW >= g.width) {
+                        continue;
+                    }
+                    const float* px = x + ((n * g.height + ih - g.padH) * g.width + iw - g.padW) * g.channels;
+                    const float* wt = wr + tap * cinG * cout;
+                    if (depthwise) {
+                        for (size_t c = 0; c < cout; ++c) d[c] += px[c] * wt[c];
+                        continue;
+                    }
+                    for (size_t grp = 0; grp < groups; ++grp) {
+                        for (size_t ic = 0; ic < cinG; ++ic) {
+                            float xv = px[grp * cinG + ic];
+                            const float* wrow = wt + ic * cout + grp * coutG;
+                            float* dd = d + grp * coutG;
+                            for (size_t o = 0; o < coutG; ++o) dd[o] += xv * wrow[o];
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+// === Pooling ===
+
+// Maximum, das NaN weiterreicht (std::max verwirft es je nach Reihenfolge)
+float maxPropagateNaN(float acc, float x) {
+    return (x > acc || x != x) ? x : acc;
+}
+
+Tensor pool2d(const Tensor& input, size_t kernel, size_t stride, size_t padding,
+              Layout layout, bool isMax, const char* op) {
+    if (kernel == 0) {
+        throw std::invalid_argument(std::string(op) + ": kernel size must be positive");
+    }
+    if (padding > kernel / 2) {
+        throw std::invalid_argument(std::string(op) + ": padding must be at most half the kernel size");
+    }
+    Geometry g;
+    readInput(input, layout, g, op);
+    g.kernelH = g.kernelW = kernel;
+    g.strideH = g.strideW = stride ? stride : kernel;
+    g.padH = g.padW = padding;
+    computeOutput(g, op);
+
+    const Tensor x = input.to(DType::Float32).contiguous();
+    Tensor result(outputShape(g, g.channels, layout));
+    const float* in = x.data();
+    float* out = result.data();
+    const float init = isMax ? -std::numeric_limits<float>::infinity() : 0.0f;
+
+    // Fensterausschnitt [lo, hi) einer Achse, auf das Bild beschnitten
+    auto window = [](size_t o, size_t stride, size_t pad, size_t k, size_t in, size_t& lo, size_t& hi) {
+        size_t start = o * stride;
+        lo = start > pad ? start - pad : 0;
+        hi = std::min(in, start + k > pad ? start + k - pad : 0);
+    };
+
+    if (layout == Layout::NCHW) {
+        size_t planes = g.batch * g.channels;
+        parallel_for(0, planes, rowsPerTask(g.outPixels() * kernel * kernel), [&](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p) {
+                const float* plane = in + p * g.inPixels();
+                float* dst = out + p * g.outPixels();
+                for (size_t oh = 0; oh < g.outH; ++oh) {
+                    size_t h0, h1;
+                    window(oh, g.strideH, g.padH, kernel, g.height, h0, h1);
+                    for (size_t ow = 0; ow < g.outW; ++ow) {
+                        size_t w0, w1;
+                        window(ow, g.strideW, g.padW, kernel, g.width, w0, w1);
+                        float acc = init;
+                        for (size_t ih = h0; ih < h1; ++ih) {
+                            const float* row = plane + ih * g.width;
+                            for (size_t iw = w0; iw < w1; ++iw) {
+                                acc = isMax ? maxPropagateNaN(acc, row[iw]) : acc + row[iw];
+                            }
+                        }
+                        dst[oh * g.outW + ow] = isMax ? acc : acc / static_cast<float>((h1 - h0) * (w1 - w0));
+                    }
+                }
+            }
+        });
+        return result;
+    }
+
+    // NHWC: ganze Kanalvektoren pro Fensterelement
+    size_t c = g.channels;
+    parallel_for(0, g.batch * g.outH, rowsPerTask(g.outW * c * kernel * kernel), [&](size_t begin, size_t end) {
+        for (size_t u = begin; u < end; ++u) {
+            size_t n = u / g.outH, oh = u % g.outH;
+            size_t h0, h1;
+            window(oh, g.strideH, g.padH, kernel, g.height, h0, h1);
+            for (size_t ow = 0; ow < g.outW; ++ow) {
+                size_t w0, w1;
+                window(ow, g.strideW, g.padW, kernel, g.width, w0, w1);
+                float* d = out + (u * g.outW + ow) * c;
+                std::fill(d, d + c, init);
+                for (size_t ih = h0; ih < h1; ++ih) {
+                    for (size_t iw = w0; iw < w1; ++iw) {
+                        const float* px = in + ((n * g.height + ih) * g.width + iw) * c;
+                        if (isMax) {
+                            for (size_t k = 0; k < c; ++k) d[k] = maxPropagateNaN(d[k], px[k]);
+                        } else {
+                            for (size_t k = 0; k < c; ++k) d[k] += px[k];
+                        }
+                    }
+                }
+                if (!isMax) {
+                    float scale = 1.0f / static_cast<float>((h1 - h0) * (w1 - w0));
+                    for (size_t k = 0; k < c; ++k) d[k] *= scale;
+                }
+            }
+        }
+    });
+    return result;
+}
+
+} // namespace
+
+Tensor conv2d(const Tensor& input, const Tensor& weight, const Tensor& bias,
+              const Conv2dOptions& options) {
+    Geometry g;
+    readInput(input, options.layout, g, "conv2d");
+    if (weight.rank() != 4) {
+        throw std::invalid_argument("conv2d expects a 4D weight, got " + weight.shapeString());
+    }
+    size_t groups = options.groups;
+    size_t cout = weight.shape()[0];
+    if (groups == 0 || g.channels % groups != 0 || cout % groups != 0) {
+        throw std::invalid_argument("conv2d: channels must be divisible by groups");
+    }
+    if (weight.shape()[1] * groups != g.channels) {
+        throw std::invalid_argument("conv2d: weight " + weight.shapeString() + " does not match " +
+                                    std::to_string(g.channels) + " input channels");
+    }
+    if (options.strideH == 0 || options.strideW == 0 || options.dilationH == 0 || options.dilationW == 0) {
+        throw std::invalid_argument("conv2d: stride and dilation must be positive");
+    }
+    if (!bias.empty() && (bias.rank() != 1 || bias.size() != cout)) {
+        throw std::invalid_argument("conv2d: bias must have " + std::to_string(cout) + " values");
+    }
+
+    g.kernelH = weight.shape()[2];
+    g.kernelW = weight.shape()[3];
+    g.strideH = options.strideH;
+    g.strideW = options.strideW;
+    g.padH = options.padH;
+    g.padW = options.padW;
+    g.dilationH = options.dilationH;
+    g.dilationW = options.dilationW;
+    computeOutput(g, "conv2d");
+
+    const bool nchw = options.layout == Layout::NCHW;
+    size_t cinG = g.channels / groups;
+    size_t coutG = cout / groups;
+    size_t depth = cinG * g.kernelH * g.kernelW;
+    size_t pixels = g.outPixels();
+
+    const Tensor x = input.to(DType::Float32).contiguous();
+    Tensor result(outputShape(g, cout, options.layout));
+    const float* in = x.data();
+    float* out = result.data();
+
+    // Bias vorab eintragen, alle Kernel akkumulieren darauf
+    if (!bias.empty()) {
+        const Tensor b = bias.to(DType::Float32).contiguous();
+        const float* bv = b.data();
+        if (nchw) {
+            parallel_for(0, g.batch * cout, rowsPerTask(pixels), [&](size_t begin, size_t end) {
+                for (size_t u = begin; u < end; ++u) {
+                    std::fill(out + u * pixels, out + (u + 1) * pixels, bv[u % cout]);
+                }
+            });
+        } else {
+            parallel_for(0, g.batch * pixels, rowsPerTask(cout), [&](size_t begin, size_t end) {
+                for (size_t u = begin; u < end; ++u) std::memcpy(out + u * cout, bv, cout * sizeof(float));
+            });
+        }
+    }
+
+    if (g.kernelH == 3 && g.kernelW == 3 && cinG <= DIRECT_MAX_GROUP_CHANNELS &&
+        coutG <= DIRECT_MAX_GROUP_CHANNELS) {
+        if (nchw) {
+            const Tensor w = weight.to(DType::Float32).contiguous();
+            direct3x3Nchw(in, w.data(), out, g, cout, groups);
+        } else {
+            const Tensor wr = weight.to(DType::Float32).transpose({2, 3, 1, 0}).contiguous();
+            direct3x3Nhwc(in, wr.data(), out, g, cout, groups);
+        }
+        return result;
+    }
+
+    // Ohne Stride/Padding ist ein 1x1-Filter schon eine Matrix über die Pixel
+    bool pointwise = g.kernelH == 1 && g.kernelW == 1 && g.strideH == 1 && g.strideW == 1 &&
+                     g.padH == 0 && g.padW == 0;
+    std::vector<float> col(pointwise ? 0 : depth * pixels);
+
+    if (nchw) {
+        // Je Bild und Gruppe: out (coutG x P) += W (coutG x K) * col (K x P)
+        const Tensor w = weight.to(DType::Float32).contiguous();
+        const float* wv = w.data();
+        for (size_t n = 0; n < g.batch; ++n) {
+            const float* img = in + n * g.channels * g.inPixels();
+            for (size_t grp = 0; grp < groups; ++grp) {
+                const float* b = img + grp * cinG * g.inPixels();
+                if (!pointwise) {
+                    im2colNchw(img, g, grp * cinG, cinG, col.data());
+                    b = col.data();
+                }
+                gemm::sgemm(coutG, pixels, depth,
+                            wv + grp * coutG * depth, depth, 1,
+                            b, pixels, 1,
+                            out + (n * cout + grp * coutG) * pixels, pixels, true);
+            }
+        }
+        return result;
+    }
+
+    // NHWC, je Bild und Gruppe: out (P x coutG) += col (P x K) * W^T (K x coutG),
+    // W mit K = (kh, kw, Kanal) wie die Spalten
+    const Tensor wr = weight.to(DType::Float32).transpose({0, 2, 3, 1}).contiguous();
+    const float* wv = wr.data();
+    for (size_t n = 0; n < g.batch; ++n) {
+        const float* img = in + n * g.inPixels() * g.channels;
+        for (size_t grp = 0; grp < groups; ++grp) {
+            const float* a = img + grp * cinG;
+            size_t rsA = g.channels;
+            if (!pointwise) {
+                im2colNhwc(img, g, grp * cinG, cinG, col.data());
+                a = col.data();
+                rsA = depth;
+            }
+            gemm::sgemm(pixels, coutG, depth,
+                        a, rsA, 1,
+                        wv + grp * coutG * depth, 1, depth,
+                        out + n * pixels * cout + grp * coutG, cout, true);
+        }
+    }
+    return result;
+}
+
+Tensor maxPool2d(const Tensor& input, size_t kernel, size_t stride, size_t padding, Layout layout) {
+    return pool2d(input, kernel, stride, padding, layout, true, "maxPool2d");
+}
+
+Tensor avgPool2d(const Tensor& input, size_t kernel, size_t stride, size_t padding, Layout layout) {
+    return pool2d(input, kernel, stride, padding, layout, false, "avgPool2d");
+}
+
+} // namespace tensor
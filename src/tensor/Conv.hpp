@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+
+/**
+ * @brief Anordnung der Achsen von Bild-Tensoren
+ *
+ * NCHW: (batch, channels, height, width), wie in Lektion 6
+ * NHWC: (batch, height, width, channels), "channels last"; die Kanäle
+ *       eines Pixels liegen zusammenhängend im Speicher
+ */
+enum class Layout {
+    NCHW,
+    NHWC
+};
+
+struct Conv2dOptions {
+    size_t strideH = 1, strideW = 1;
+    size_t padH = 0, padW = 0;           // Nullen an jedem Rand
+    size_t dilationH = 1, dilationW = 1; // Abstand der Filterabgriffe
+    size_t groups = 1;                   // Kanäle in groups unabhängige Gruppen
+    Layout layout = Layout::NCHW;
+};
+
+/**
+ * @brief 2D-Faltung (genauer: Kreuzkorrelation) über einen Batch
+ *
+ * weight hat unabhängig vom Layout die Form (outChannels,
+ * inChannels / groups, kernelH, kernelW), bias ist leer oder hat
+ * outChannels Werte. Die Ausgabe hat das Layout der Eingabe und ist
+ * immer float32.
+ *
+ * Allgemein wird über im2col auf die blockierte GEMM zurückgeführt
+ * (1x1-Filter ohne Stride/Padding direkt ohne im2col). Kleine 3x3-Filter
+ * mit wenigen Kanälen pro Gruppe (z.B. depthwise) laufen über
+ * einen direkten Kernel, bei dem sich GEMM-Packen nicht lohnt.
+ */
+Tensor conv2d(const Tensor& input, const Tensor& weight, const Tensor& bias = Tensor(),
+              const Conv2dOptions& options = {});
+
+/**
+ * @brief Max- bzw. Average-Pooling mit quadratischem Fenster
+ *
+ * stride 0 bedeutet stride = kernel. Padding höchstens kernel / 2;
+ * gepolsterte Positionen zählen nicht mit (Maximum bzw. Mittelwert nur
+ * über die gültigen Elemente). Ergebnis float32 im Layout der Eingabe.
+ */
+Tensor maxPool2d(const Tensor& input, size_t kernel, size_t stride = 0, size_t padding = 0,
+                 Layout layout = Layout::NCHW);
+Tensor avgPool2d(const Tensor& input, size_t kernel, size_t stride = 0, size_t padding = 0,
+                 Layout layout = Layout::NCHW);
+
+} // namespace tensor
@@ -0,0 +1,318 @@
+#include "tensor/DType.hpp"
+#include "tensor/Simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace tensor {
+
+namespace {
+
+// === Skalare Umwandlung ===
+
+uint32_t floatBits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float bitsFloat(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+uint16_t floatToHalf(float f) {
+    uint32_t x = floatBits(f);
+    uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000);
+    uint32_t a = x & 0x7FFFFFFF;
+
+    if (a >= 0x7F800000) return sign | (a > 0x7F800000 ? 0x7E00 : 0x7C00);
+    // Ab 65520 rundet der Wert über das Maximum 65504 hinaus
+    if (a >= 0x477FF000) return sign | 0x7C00;
+    if (a < 0x38800000) {
+        // Denormal: Vielfache von 2^-24, Skalierung mit 2^24 ist exakt
+        return sign | static_cast<uint16_t>(std::nearbyint(bitsFloat(a) * 16777216.0f));
+    }
+
+    uint32_t h = (((a >> 23) - 112) << 10) | ((a >> 13) & 0x3FF);
+    uint32_t rest = a & 0x1FFF;
+    // Übertrag in den Exponenten ist gewollt
+    if (rest > 0x1000 || (rest == 0x1000 && (h & 1))) ++h;
+    return sign | static_cast<uint16_t>(h);
+}
+
+float halfToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1F;
+    uint32_t mant = h & 0x3FF;
+
+    if (exp == 0) {
+        float v = static_cast<float>(mant) * 5.9604644775390625e-8f;  // 2^-24
+        return sign ? -v : v;
+    }
+    if (exp == 31) return bitsFloat(sign | 0x7F800000 | (mant << 13));
+    return bitsFloat(sign | ((exp + 112) << 23) | (mant << 13));
+}
+
+uint16_t floatToBFloat(float f) {
+    uint32_t x = floatBits(f);
+    // NaN bleibt (ruhiges) NaN, statt beim Runden zu Inf zu werden
+    if ((x & 0x7FFFFFFF) > 0x7F800000) return static_cast<uint16_t>((x >> 16) | 0x0040);
+    x += 0x7FFF + ((x >> 16) & 1);
+    return static_cast<uint16_t>(x >> 16);
+}
+
+float bfloatToFloat(uint16_t b) {
+    return bitsFloat(static_cast<uint32_t>(b) << 16);
+}
+
+template <typename I>
+I saturate(double v) {
+    if (!(v == v)) return 0;
+    if (v <= static_cast<double>(std::numeric_limits<I>::min())) return std::numeric_limits<I>::min();
+    if (v >= static_cast<double>(std::numeric_limits<I>::max())) return std::numeric_limits<I>::max();
+    return static_cast<I>(v);
+}
+
+// Jeder Typ ist als double exakt darstellbar
+double loadAsDouble(const void* src, size_t i, DType dtype) {
+    switch (dtype) {
+        case DType::Float32: return static_cast<const float*>(src)[i];
+        case DType::Float64: return static_cast<const double*>(src)[i];
+        case DType::Float16: return halfToFloat(static_cast<const uint16_t*>(src)[i]);
+        case DType::BFloat16: return bfloatToFloat(static_cast<const uint16_t*>(src)[i]);
+        case DType::Int32: return static_cast<const int32_t*>(src)[i];
+        case DType::Int8: return static_cast<const int8_t*>(src)[i];
+    }
+    return 0.0;
+}
+
+void storeFromDouble(double v, void* dst, size_t i, DType dtype) {
+    switch (dtype) {
+        case DType::Float32: static_cast<float*>(dst)[i] = static_cast<float>(v); break;
+        case DType::Float64: static_cast<double*>(dst)[i] = v; break;
+        case DType::Float16: static_cast<uint16_t*>(dst)[i] = floatToHalf(static_cast<float>(v)); break;
+        case DType::BFloat16: static_cast<uint16_t*>(dst)[i] = floatToBFloat(static_cast<float>(v)); break;
+        case DType::Int32: static_cast<int32_t*>(dst)[i] = saturate<int32_t>(v); break;
+        case DType::Int8: static_cast<int8_t*>(dst)[i] = saturate<int8_t>(v); break;
+    }
+}
+
+#if TENSOR_X86
+
+// === Vektorisierte Kernel (je 8 Elemente) ===
+
+TENSOR_TARGET("avx,f16c")
+size_t halfToFloatF16c(const uint16_t* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    return i;
+}
+
+TENSOR_TARGET("avx,f16c")
+size_t floatToHalfF16c(const float* in, uint16_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    return i;
+}
+
+TENSOR_TARGET("avx2")
+size_t bfloatToFloatAvx2(const uint16_t* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i b = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi32(b, 16));
+    }
+    return i;
+}
+
+TENSOR_TARGET("avx2")
+size_t floatToBFloatAvx2(const float* in, uint16_t* out, size_t n) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i bias = _mm256_set1_epi32(0x7FFF);
+    const __m256i quiet = _mm256_set1_epi32(0x00400000);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i);
+        __m256i bits = _mm256_castps_si256(x);
+        __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(bias, lsb));
+        __m256 nan = _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+        rounded = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(rounded),
+            _mm256_castsi256_ps(_mm256_or_si256(bits, quiet)), nan));
+        __m256i hi = _mm256_srli_epi32(rounded, 16);
+        __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(hi), _mm256_extracti128_si256(hi, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    return i;
+}
+
+#endif
+
+bool useF16c() {
+    static const bool f16c = simd::cpu().avx && simd::cpu().f16c;
+    return f16c;
+}
+
+bool useAvx2() {
+    static const bool avx2 = simd::cpu().avx2;
+    return avx2;
+}
+
+// === float32 <-> Speicherformat ===
+
+void toFloat(const void* src, DType from, float* out, size_t n) {
+    size_t i = 0;
+    switch (from) {
+        case DType::Float16: {
+            const uint16_t* in = static_cast<const uint16_t*>(src);
+#if TENSOR_X86
+            if (useF16c()) i = halfToFloatF16c(in, out, n);
+#endif
+            for (; i < n; ++i) out[i] = halfToFloat(in[i]);
+            return;
+        }
+        case DType::BFloat16: {
+            const uint16_t* in = static_cast<const uint16_t*>(src);
+#if TENSOR_X86
+            if (useAvx2()) i = bfloatToFloatAvx2(in, out, n);
+#endif
+            for (; i < n; ++i) out[i] = bfloatToFloat(in[i]);
+            return;
+        }
+        case DType::Float64: {
+            const double* in = static_cast<const double*>(src);
+            for (; i < n; ++i) out[i] = static_cast<float>(in[i]);
+            return;
+        }
+        case DType::Int32: {
+            const int32_t* in = static_cast<const int32_t*>(src);
+            for (; i < n; ++i) out[i] = static_cast<float>(in[i]);
+            return;
+        }
+        case DType::Int8: {
+            const int8_t* in = static_cast<const int8_t*>(src);
+            for (; i < n; ++i) out[i] = static_cast<float>(in[i]);
+            return;
+        }
+        case DType::Float32:
+            std::memcpy(out, src, n * sizeof(float));
+            return;
+    }
+}
+
+void fromFloat(const float* in, void* dst, DType to, size_t n) {
+    size_t i = 0;
+    switch (to) {
+        case DType::Float16: {
+            uint16_t* out = static_cast<uint16_t*>(dst);
+#if TENSOR_X86
+            if (useF16c()) i = floatToHalfF16c(in, out, n);
+#endif
+            for (; i < n; ++i) out[i] = floatToHalf(in[i]);
+            return;
+        }
+        case DType::BFloat16: {
+            uint16_t* out = static_cast<uint16_t*>(dst);
+#if TENSOR_X86
+            if (useAvx2()) i = floatToBFloatAvx2(in, out, n);
+#endif
+            for (; i < n; ++i) out[i] = floatToBFloat(in[i]);
+            return;
+        }
+        case DType::Float64: {
+            double* out = static_cast<double*>(dst);
+            for (; i < n; ++i) out[i] = in[i];
+            return;
+        }
+        case DType::Int32: {
+            int32_t* out = static_cast<int32_t*>(dst);
+            for (; i < n; ++i) out[i] = saturate<int32_t>(in[i]);
+            return;
+        }
+        case DType::Int8: {
+            int8_t* out = static_cast<int8_t*>(dst);
+            // Begrenzen in float hält die Schleife vektorisierbar
+            for (; i < n; ++i) {
+                float v = in[i] == in[i] ? std::min(std::max(in[i], -128.0f), 127.0f) : 0.0f;
+                out[i] = static_cast<int8_t>(v);
+            }
+            return;
+        }
+        case DType::Float32:
+            std::memcpy(dst, in, n * sizeof(float));
+            return;
+    }
+}
+
+} // namespace
+
+const char* dtypeName(DType dtype) {
+    switch (dtype) {
+        case DType::Float32: return "float32";
+        case DType::Float64: return "float64";
+        case DType::Float16: return "float16";
+        case DType::BFloat16: return "bfloat16";
+        case DType::Int32: return "int32";
+        case DType::Int8: return "int8";
+    }
+    return "unknown";
+}
+
+DType parseDType(const std::string& name) {
+    for (DType d : {DType::Float32, DType::Float64, DType::Float16,
+                    DType::BFloat16, DType::Int32, DType::Int8}) {
+        if (name == dtypeName(d)) return d;
+    }
+    throw std::invalid_argument("Unknown dtype: " + name);
+}
+
+DType promoteTypes(DType a, DType b) {
+    if (a == b) return a;
+    if (a == DType::Float64 || b == DType::Float64) return DType::Float64;
+    if (a == DType::Float32 || b == DType::Float32) return DType::Float32;
+    if (isFloating(a) && isFloating(b)) return DType::Float32;  // float16 + bfloat16
+    if (isFloating(a)) return a;
+    if (isFloating(b)) return b;
+    return DType::Int32;  // int8 + int32
+}
+
+DType promoteScalar(DType dtype, float value) {
+    if (isFloating(dtype) || std::trunc(value) == value) return dtype;
+    return DType::Float32;
+}
+
+void convert(const void* src, DType from, void* dst, DType to, size_t n) {
+    if (from == to) {
+        std::memcpy(dst, src, n * dtypeSize(from));
+    } else if (to == DType::Float32) {
+        toFloat(src, from, static_cast<float*>(dst), n);
+    } else if (from == DType::Float32) {
+        fromFloat(static_cast<const float*>(src), dst, to, n);
+    } else {
+        // Zwischen zwei Nicht-float32-Typen über double, damit int32 und
+        // float64 nicht auf float32-Genauigkeit fallen
+        for (size_t i = 0; i < n; ++i) storeFromDouble(loadAsDouble(src, i, from), dst, i, to);
+    }
+}
+
+float loadAsFloat(const void* src, DType dtype) {
+    float v;
+    toFloat(src, dtype, &v, 1);
+    return v;
+}
+
+void storeFromFloat(float value, void* dst, DType dtype) {
+    fromFloat(&value, dst, dtype, 1);
+}
+
+} // namespace tensor
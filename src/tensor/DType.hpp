@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tensor {
+
+/**
+ * @brief Elementtyp des Speichers eines Tensors
+ *
+ * Gerechnet wird immer in float32: Operanden anderer Typen werden beim
+ * Lesen blockweise umgewandelt, Ergebnisse beim Schreiben zurück. Kompakte
+ * Typen sparen so Speicher für Tensoren, die lange liegen bleiben (Gewichte
+ * in bfloat16, Masken in int8), ohne eigene Kernel pro Typ.
+ *
+ * float64 speichert Werte verlustfrei (z.B. aus Dateien), Rechnungen damit
+ * haben aber float32-Genauigkeit. Dasselbe gilt für int32 jenseits 2^24.
+ */
+enum class DType : uint8_t {
+    Float32,
+    Float64,
+    Float16,
+    BFloat16,
+    Int32,
+    Int8
+};
+
+// Bytes pro Element
+constexpr size_t dtypeSize(DType dtype) {
+    switch (dtype) {
+        case DType::Float64: return 8;
+        case DType::Float16:
+        case DType::BFloat16: return 2;
+        case DType::Int8: return 1;
+        default: return 4;
+    }
+}
+
+constexpr bool isFloating(DType dtype) {
+    return dtype != DType::Int32 && dtype != DType::Int8;
+}
+
+// Name wie in NumPy ("float32", "bfloat16", ...)
+const char* dtypeName(DType dtype);
+
+// Umkehrung von dtypeName; wirft bei unbekannten Namen
+DType parseDType(const std::string& name);
+
+// === Typ-Promotion ===
+
+/**
+ * @brief Ergebnistyp einer Operation auf zwei Tensoren
+ *
+ * Der Typ, der beide Wertebereiche fasst: int8 < int32 < Gleitkomma,
+ * float16 und bfloat16 zusammen ergeben float32, float64 gewinnt immer.
+ * Ganzzahlen mit float16/bfloat16 ergeben den Gleitkommatyp.
+ */
+DType promoteTypes(DType a, DType b);
+
+// Skalare zählen schwach: sie ändern Gleitkommatypen nie, Ganzzahltypen
+// nur, wenn der Wert selbst nicht ganzzahlig ist (dann float32)
+DType promoteScalar(DType dtype, float value);
+
+// Ergebnistyp von Operationen, die Gleitkomma liefern (/, sqrt, exp, ...)
+constexpr DType floatingType(DType dtype) {
+    return isFloating(dtype) ? dtype : DType::Float32;
+}
+
+// === Umwandlung ===
+
+/**
+ * @brief Wandelt n Elemente von src (Typ from) nach dst (Typ to) um
+ *
+ * Gleitkomma rundet zum nächsten Wert (bei Gleichstand gerade), zu große
+ * Werte werden ±Inf. Ganzzahlen werden wie static_cast abgeschnitten,
+ * aber auf ihren Wertebereich begrenzt; NaN wird 0. Der Weg zwischen
+ * float32 und float16/bfloat16 ist auf AVX2/F16C vektorisiert.
+ */
+void convert(const void* src, DType from, void* dst, DType to, size_t n);
+
+// Einzelwerte in/aus dem Speicherformat (für Skalare und Sonderfälle)
+float loadAsFloat(const void* src, DType dtype);
+void storeFromFloat(float value, void* dst, DType dtype);
+
+} // namespace tensor
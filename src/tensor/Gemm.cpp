@@ -0,0 +1,482 @@
+#include "tensor/Gemm.hpp"
+#include "tensor/Allocator.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/Simd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tensor {
+namespace gemm {
+
+namespace {
+
+// Micro-Kernel: berechnet eine volle MR x NR Kachel aus gepackten Panels
+using MicroKernel = void (*)(size_t kc, const float* a, const float* b,
+                             float* c, size_t ldc, bool accumulate);
+
+struct KernelConfig {
+    Kernel id;
+    size_t mr, nr;      // Registerkachel
+    size_t mc, kc, nc;  // L2 (A-Block), L1 (Panel-Tiefe), L3 (B-Block)
+    MicroKernel fn;
+};
+
+constexpr size_t MAX_MR = 6;
+constexpr size_t MAX_NR = 16;
+
+// Unterhalb dieser Arbeitsmenge lohnt sich das Packen nicht
+constexpr size_t SMALL_GEMM_FLOPS = 32 * 32 * 32;
+
+// Ab dieser Arbeitsmenge wird auf den Scheduler verteilt
+constexpr size_t PARALLEL_GEMM_FLOPS = 128 * 128 * 128;
+
+// === Micro-Kernel ===
+
+void kernelScalar4x4(size_t kc, const float* a, const float* b,
+                     float* c, size_t ldc, bool accumulate) {
+    float acc[4][4] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t i = 0; i < 4; ++i) {
+            float ai = a[i];
+            for (size_t j = 0; j < 4; ++j) {
+                acc[i][j] += ai * b[j];
+            }
+        }
+        a += 4;
+        b += 4;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        float* row = c + i * ldc;
+        for (size_t j = 0; j < 4; ++j) {
+            row[j] = accumulate ? row[j] + acc[i][j] : acc[i][j];
+        }
+    }
+}
+
+#if TENSOR_X86
+
+TENSOR_TARGET("sse2")
+inline void storeRowSse(float* dst, __m128 lo, __m128 hi, bool accumulate) {
+    if (accumulate) {
+        lo = _mm_add_ps(lo, _mm_loadu_ps(dst));
+        hi = _mm_add_ps(hi, _mm_loadu_ps(dst + 4));
+    }
+    _mm_storeu_ps(dst, lo);
+    _mm_storeu_ps(dst + 4, hi);
+}
+
+TENSOR_TARGET("sse2")
+void kernelSse4x8(size_t kc, const float* a, const float* b,
+                  float* c, size_t ldc, bool accumulate) {
+    __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps();
+    __m128 c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+    __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps();
+    __m128 c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+
+    for (size_t p = 0; p < kc; ++p) {
+        __m128 b0 = _mm_loadu_ps(b);
+        __m128 b1 = _mm_loadu_ps(b + 4);
+        __m128 av;
+
+        av = _mm_set1_ps(a[0]);
+        c00 = _mm_add_ps(c00, _mm_mul_ps(av, b0));
+        c01 = _mm_add_ps(c01, _mm_mul_ps(av, b1));
+        av = _mm_set1_ps(a[1]);
+        c10 = _mm_add_ps(c10, _mm_mul_ps(av, b0));
+        c11 = _mm_add_ps(c11, _mm_mul_ps(av, b1));
+        av = _mm_set1_ps(a[2]);
+        c20 = _mm_add_ps(c20, _mm_mul_ps(av, b0));
+        c21 = _mm_add_ps(c21, _mm_mul_ps(av, b1));
+        av = _mm_set1_ps(a[3]);
+        c30 = _mm_add_ps(c30, _mm_mul_ps(av, b0));
+        c31 = _mm_add_ps(c31, _mm_mul_ps(av, b1));
+
+        a += 4;
+        b += 8;
+    }
+
+    storeRowSse(c, c00, c01, accumulate);
+    storeRowSse(c + ldc, c10, c11, accumulate);
+    storeRowSse(c + 2 * ldc, c20, c21, accumulate);
+    storeRowSse(c + 3 * ldc, c30, c31, accumulate);
+}
+
+TENSOR_TARGET("avx2,fma")
+inline void storeRowAvx(float* dst, __m256 lo, __m256 hi, bool accumulate) {
+    if (accumulate) {
+        lo = _mm256_add_ps(lo, _mm256_loadu_ps(dst));
+        hi = _mm256_add_ps(hi, _mm256_loadu_ps(dst + 8));
+    }
+    _mm256_storeu_ps(dst, lo);
+    _mm256_storeu_ps(dst + 8, hi);
+}
+
+TENSOR_TARGET("avx2,fma")
+void kernelAvx2_6x16(size_t kc, const float* a, const float* b,
+                     float* c, size_t ldc, bool accumulate) {
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+    for (size_t p = 0; p < kc; ++p) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+        __m256 av;
+
+        av = _mm256_broadcast_ss(a + 0);
+        c00 = _mm256_fmadd_ps(av, b0, c00);
+        c01 = _mm256_fmadd_ps(av, b1, c01);
+        av = _mm256_broadcast_ss(a + 1);
+        c10 = _mm256_fmadd_ps(av, b0, c10);
+        c11 = _mm256_fmadd_ps(av, b1, c11);
+        av = _mm256_broadcast_ss(a + 2);
+        c20 = _mm256_fmadd_ps(av, b0, c20);
+        c21 = _mm256_fmadd_ps(av, b1, c21);
+        av = _mm256_broadcast_ss(a + 3);
+        c30 = _mm256_fmadd_ps(av, b0, c30);
+        c31 = _mm256_fmadd_ps(av, b1, c31);
+        av = _mm256_broadcast_ss(a + 4);
+        c40 = _mm256_fmadd_ps(av, b0, c40);
+        c41 = _mm256_fmadd_ps(av, b1, c41);
+        av = _mm256_broadcast_ss(a + 5);
+        c50 = _mm256_fmadd_ps(av, b0, c50);
+        c51 = _mm256_fmadd_ps(av, b1, c51);
+
+        a += 6;
+        b += 16;
+    }
+
+    storeRowAvx(c, c00, c01, accumulate);
+    storeRowAvx(c + ldc, c10, c11, accumulate);
+    storeRowAvx(c + 2 * ldc, c20, c21, accumulate);
+    storeRowAvx(c + 3 * ldc, c30, c31, accumulate);
+    storeRowAvx(c + 4 * ldc, c40, c41, accumulate);
+    storeRowAvx(c + 5 * ldc, c50, c51, accumulate);
+}
+
+#endif
+
+const KernelConfig SCALAR_CONFIG = {Kernel::Scalar, 4, 4, 64, 256, 1024, kernelScalar4x4};
+#if TENSOR_X86
+const KernelConfig SSE_CONFIG = {Kernel::SSE, 4, 8, 128, 256, 2048, kernelSse4x8};
+const KernelConfig AVX2_CONFIG = {Kernel::AVX2, 6, 16, 144, 256, 4080, kernelAvx2_6x16};
+#endif
+
+std::atomic<int> forcedKernel{-1};
+
+const KernelConfig& configFor(Kernel kernel) {
+    switch (kernel) {
+#if TENSOR_X86
+        case Kernel::AVX2: return AVX2_CONFIG;
+        case Kernel::SSE: return SSE_CONFIG;
+#endif
+        default: return SCALAR_CONFIG;
+    }
+}
+
+Kernel bestKernel() {
+    if (isSupported(Kernel::AVX2)) return Kernel::AVX2;
+    if (isSupported(Kernel::SSE)) return Kernel::SSE;
+    return Kernel::Scalar;
+}
+
+// === Packen ===
+
+// A-Block (mc x kc) in Panels zu je mr Zeilen, spaltenweise verschachtelt
+void packA(size_t mc, size_t kc, size_t mr,
+           const float* a, size_t rsA, size_t csA, float* buf) {
+    for (size_t i = 0; i < mc; i += mr) {
+        size_t rows = std::min(mr, mc - i);
+        const float* src = a + i * rsA;
+        for (size_t p = 0; p < kc; ++p) {
+            const float* col = src + p * csA;
+            size_t r = 0;
+            for (; r < rows; ++r) buf[r] = col[r * rsA];
+            for (; r < mr; ++r) buf[r] = 0.0f;
+            buf += mr;
+        }
+    }
+}
+
+// B-Block (kc x nc) in Panels zu je nr Spalten, zeilenweise verschachtelt
+void packB(size_t kc, size_t nc, size_t nr,
+           const float* b, size_t rsB, size_t csB, float* buf) {
+    for (size_t j = 0; j < nc; j += nr) {
+        size_t cols = std::min(nr, nc - j);
+        const float* src = b + j * csB;
+        for (size_t p = 0; p < kc; ++p) {
+            const float* row = src + p * rsB;
+            size_t c = 0;
+            if (csB == 1) {
+                std::copy(row, row + cols, buf);
+                c = cols;
+            } else {
+                for (; c < cols; ++c) buf[c] = row[c * csB];
+            }
+            for (; c < nr; ++c) buf[c] = 0.0f;
+            buf += nr;
+        }
+    }
+}
+
+// === Kleine Matrizen ===
+
+void sgemmSmall(size_t m, size_t n, size_t k,
+                const float* a, size_t rsA, size_t csA,
+                const float* b, size_t rsB, size_t csB,
+                float* c, size_t ldc, bool accumulate, const Epilogue& epilogue = {}) {
+    for (size_t i = 0; i < m; ++i) {
+        float* crow = c + i * ldc;
+        if (!accumulate) std::fill(crow, crow + n, 0.0f);
+        for (size_t p = 0; p < k; ++p) {
+            float aip = a[i * rsA + p * csA];
+            const float* brow = b + p * rsB;
+            if (csB == 1) {
+                for (size_t j = 0; j < n; ++j) crow[j] += aip * brow[j];
+            } else {
+                for (size_t j = 0; j < n; ++j) crow[j] += aip * brow[j * csB];
+            }
+        }
+        if (epilogue.fn) epilogue.fn(epilogue.ctx, crow, ldc, 1, n, i, 0);
+    }
+}
+
+// === Blockierte GEMM ===
+
+// Makro-Kernel: ein gepackter A-Block gegen einen Spaltenbereich des B-Blocks.
+// epilogue (nur beim letzten K-Block) läuft je fertigem mc x nr Streifen,
+// (row0, col0) ist die Lage von c im gesamten C
+void macroKernel(const KernelConfig& cfg, size_t mc, size_t kc,
+                 size_t jBegin, size_t jEnd,
+                 const float* packedA, const float* packedB,
+                 float* c, size_t ldc, bool acc,
+                 const Epilogue* epilogue, size_t row0, size_t col0) {
+    const size_t mr = cfg.mr;
+    const size_t nr = cfg.nr;
+    float tile[MAX_MR * MAX_NR];
+
+    for (size_t jr = jBegin; jr < jEnd; jr += nr) {
+        size_t cols = std::min(nr, jEnd - jr);
+        const float* bp = packedB + jr * kc;
+
+        for (size_t ir = 0; ir < mc; ir += mr) {
+            size_t rows = std::min(mr, mc - ir);
+            const float* ap = packedA + ir * kc;
+            float* cp = c + ir * ldc + jr;
+
+            if (rows == mr && cols == nr) {
+                cfg.fn(kc, ap, bp, cp, ldc, acc);
+            } else {
+                // Randkachel über Zwischenpuffer
+                cfg.fn(kc, ap, bp, tile, nr, false);
+                for (size_t i = 0; i < rows; ++i) {
+                    float* dst = cp + i * ldc;
+                    const float* src = tile + i * nr;
+                    for (size_t j = 0; j < cols; ++j) {
+                        dst[j] = acc ? dst[j] + src[j] : src[j];
+                    }
+                }
+            }
+        }
+        if (epilogue) epilogue->fn(epilogue->ctx, c + jr, ldc, mc, cols, row0, col0 + jr);
+    }
+}
+
+// Puffer aus dem Allocator für die Dauer eines Aufrufs
+class PackBuffer {
+public:
+    explicit PackBuffer(size_t count)
+        : data_(static_cast<float*>(Allocator::instance().allocate(count * sizeof(float)))),
+          bytes_(count * sizeof(float)) {}
+    ~PackBuffer() { Allocator::instance().deallocate(data_, bytes_); }
+
+    PackBuffer(const PackBuffer&) = delete;
+    PackBuffer& operator=(const PackBuffer&) = delete;
+
+    float* data() { return data_; }
+
+private:
+    float* data_;
+    size_t bytes_;
+};
+
+void sgemmBlocked(const KernelConfig& cfg, size_t m, size_t n, size_t k,
+                  const float* a, size_t rsA, size_t csA,
+                  const float* b, size_t rsB, size_t csB,
+                  float* c, size_t ldc, bool accumulate, const Epilogue& epilogue) {
+    const size_t mr = cfg.mr;
+    const size_t nr = cfg.nr;
+    const size_t mcRounded = (cfg.mc + mr - 1) / mr * mr;
+    const size_t ncRounded = (cfg.nc + nr - 1) / nr * nr;
+
+    // Gepacktes B gehört dem Aufruf, nicht dem Thread: Wer in parallel_for
+    // wartet, arbeitet fremde Aufgaben ab, womöglich ein anderes GEMM, das
+    // einen Puffer pro Thread überschreiben würde, während unsere A-Blöcke
+    // noch daraus lesen. Der Allocator liefert gleich große Puffer aus dem Cache.
+    PackBuffer packedB(cfg.kc * ncRounded);
+
+    const bool parallel = m * n * k >= PARALLEL_GEMM_FLOPS;
+    const size_t threads = parallel ? Scheduler::instance().threadCount() : 1;
+
+    for (size_t jc = 0; jc < n; jc += cfg.nc) {
+        size_t nc = std::min(cfg.nc, n - jc);
+        size_t panels = (nc + nr - 1) / nr;
+
+        for (size_t pc = 0; pc < k; pc += cfg.kc) {
+            size_t kc = std::min(cfg.kc, k - pc);
+            bool acc = accumulate || pc > 0;
+            const Epilogue* ep = epilogue.fn && pc + kc >= k ? &epilogue : nullptr;
+
+            const float* bBlock = b + pc * rsB + jc * csB;
+            float* bPacked = packedB.data();
+            parallel_for(0, panels, parallel ? 8 : panels, [&](size_t p0, size_t p1) {
+                size_t j0 = p0 * nr;
+                size_t j1 = std::min(nc, p1 * nr);
+                packB(kc, j1 - j0, nr, bBlock + j0 * csB, rsB, csB, bPacked + j0 * kc);
+            });
+
+            // Aufgaben: A-Blöcke, bei wenigen Zeilen zusätzlich Spaltenstreifen
+            size_t mBlocks = (m + cfg.mc - 1) / cfg.mc;
+            size_t nSplit = 1;
+            if (mBlocks < threads) {
+                nSplit = std::min(panels, (threads + mBlocks - 1) / mBlocks);
+            }
+            size_t panelsPerSplit = (panels + nSplit - 1) / nSplit;
+
+            parallel_for(0, mBlocks * nSplit, 1, [&](size_t t0, size_t t1) {
+                thread_local std::vector<float> packedA;
+                packedA.resize(mcRounded * cfg.kc);
+
+                size_t packedBlock = static_cast<size_t>(-1);
+                for (size_t t = t0; t < t1; ++t) {
+                    size_t block = t / nSplit;
+                    size_t split = t % nSplit;
+                    size_t ic = block * cfg.mc;
+                    size_t mc = std::min(cfg.mc, m - ic);
+
+                    size_t jBegin = split * panelsPerSplit * nr;
+                    size_t jEnd = std::min(nc, jBegin + panelsPerSplit * nr);
+                    if (jBegin >= jEnd) continue;
+
+                    if (block != packedBlock) {
+                        packA(mc, kc, mr, a + ic * rsA + pc * csA, rsA, csA, packedA.data());
+                        packedBlock = block;
+                    }
+                    macroKernel(cfg, mc, kc, jBegin, jEnd, packedA.data(), bPacked,
+                                c + ic * ldc + jc, ldc, acc, ep, ic, jc);
+                }
+            });
+        }
+    }
+}
+
+} // namespace
+
+void sgemm(size_t m, size_t n, size_t k,
+           const float* a, size_t rsA, size_t csA,
+           const float* b, size_t rsB, size_t csB,
+           float* c, size_t ldc, bool accumulate, const Epilogue& epilogue) {
+    if (m == 0 || n == 0) return;
+
+    if (k == 0) {
+        if (!accumulate) {
+            for (size_t i = 0; i < m; ++i) {
+                std::fill(c + i * ldc, c + i * ldc + n, 0.0f);
+            }
+        }
+        if (epilogue.fn) epilogue.fn(epilogue.ctx, c, ldc, m, n, 0, 0);
+        return;
+    }
+
+    if (m * n * k <= SMALL_GEMM_FLOPS) {
+        sgemmSmall(m, n, k, a, rsA, csA, b, rsB, csB, c, ldc, accumulate, epilogue);
+        return;
+    }
+
+    sgemmBlocked(configFor(activeKernel()), m, n, k,
+                 a, rsA, csA, b, rsB, csB, c, ldc, accumulate, epilogue);
+}
+
+void sgemmBatched(size_t batch, size_t m, size_t n, size_t k,
+                  const float* a, const size_t* offsetsA, size_t rsA, size_t csA,
+                  const float* b, const size_t* offsetsB, size_t rsB, size_t csB,
+                  float* c, size_t ldc, size_t strideC) {
+    if (batch == 0 || m == 0 || n == 0) return;
+
+    size_t flops = std::max<size_t>(1, m * n * k);
+    if (batch == 1 || flops >= PARALLEL_GEMM_FLOPS) {
+        for (size_t i = 0; i < batch; ++i) {
+            sgemm(m, n, k, a + offsetsA[i], rsA, csA, b + offsetsB[i], rsB, csB,
+                  c + i * strideC, ldc);
+        }
+        return;
+    }
+
+    // Viele kleine Probleme: so viele pro Aufgabe, dass sich die Verteilung
+    // lohnt; sehr kleine direkt ohne Packen und ohne Dispatch pro Matrix
+    bool small = k > 0 && flops <= SMALL_GEMM_FLOPS;
+    size_t grain = std::max<size_t>(1, PARALLEL_GEMM_FLOPS / flops);
+    parallel_for(0, batch, grain, [&](size_t b0, size_t b1) {
+        for (size_t i = b0; i < b1; ++i) {
+            if (small) {
+                sgemmSmall(m, n, k, a + offsetsA[i], rsA, csA, b + offsetsB[i], rsB, csB,
+                           c + i * strideC, ldc, false);
+            } else {
+                sgemm(m, n, k, a + offsetsA[i], rsA, csA, b + offsetsB[i], rsB, csB,
+                      c + i * strideC, ldc);
+            }
+        }
+    });
+}
+
+Kernel activeKernel() {
+    int forced = forcedKernel.load(std::memory_order_relaxed);
+    if (forced >= 0) return static_cast<Kernel>(forced);
+    static const Kernel best = bestKernel();
+    return best;
+}
+
+void setKernel(Kernel kernel) {
+    if (!isSupported(kernel)) {
+        throw std::invalid_argument(std::string("GEMM kernel not supported on this CPU: ") +
+                                    kernelName(kernel));
+    }
+    forcedKernel.store(static_cast<int>(kernel), std::memory_order_relaxed);
+}
+
+void resetKernel() {
+    forcedKernel.store(-1, std::memory_order_relaxed);
+}
+
+bool isSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#if TENSOR_X86
+        case Kernel::SSE:
+            return simd::cpu().sse2;
+        case Kernel::AVX2:
+            return simd::cpu().avx2 && simd::cpu().fma;
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* kernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar: return "scalar";
+        case Kernel::SSE: return "sse";
+        case Kernel::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+} // namespace gemm
+} // namespace tensor
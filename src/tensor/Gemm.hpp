@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+
+namespace tensor {
+namespace gemm {
+
+/**
+ * @brief Verfügbare Micro-Kernel der GEMM-Engine
+ *
+ * Die Auswahl erfolgt zur Laufzeit anhand der CPU-Features;
+ * Scalar ist der portable Fallback für alle Plattformen.
+ */
+enum class Kernel {
+    Scalar,
+    SSE,
+    AVX2
+};
+
+/**
+ * @brief Nachbearbeitung von C, solange die Kacheln noch im Cache liegen
+ *
+ * fn(ctx, c, ldc, rows, cols, row0, col0) erhält einen fertig
+ * berechneten Block ab C[row0][col0] (Indizes relativ zum C der
+ * sgemm) und darf ihn in-place ändern, z.B. Bias + Aktivierung. Jedes
+ * Element wird genau einmal übergeben; Aufrufe laufen ggf. parallel.
+ */
+struct Epilogue {
+    using Fn = void (*)(const void* ctx, float* c, size_t ldc, size_t rows, size_t cols,
+                        size_t row0, size_t col0);
+    Fn fn = nullptr;
+    const void* ctx = nullptr;
+};
+
+/**
+ * @brief Matrixmultiplikation C = A * B (bzw. C += A * B)
+ *
+ * A ist (m x k) mit Zeilen-/Spaltenstride (rsA, csA), B ist (k x n) mit
+ * (rsB, csB). Durch die freien Strides können transponierte Operanden
+ * ohne Kopie übergeben werden. C ist zeilenweise mit Leading Dimension ldc.
+ *
+ * Intern werden A- und B-Panels gepackt und in L1/L2/L3-Blöcken
+ * an den Micro-Kernel übergeben.
+ */
+void sgemm(size_t m, size_t n, size_t k,
+           const float* a, size_t rsA, size_t csA,
+           const float* b, size_t rsB, size_t csB,
+           float* c, size_t ldc, bool accumulate = false,
+           const Epilogue& epilogue = {});
+
+/**
+ * @brief batch unabhängige Multiplikationen C_i = A_i * B_i
+ *
+ * A_i beginnt bei a + offsetsA[i], B_i bei b + offsetsB[i] (in Elementen,
+ * gleiche Offsets für gebroadcastete Operanden erlaubt), C_i bei
+ * c + i * strideC. Große Probleme laufen nacheinander und jeweils intern
+ * parallel; kleine werden gruppenweise parallel ohne Packen gerechnet.
+ */
+void sgemmBatched(size_t batch, size_t m, size_t n, size_t k,
+                  const float* a, const size_t* offsetsA, size_t rsA, size_t csA,
+                  const float* b, const size_t* offsetsB, size_t rsB, size_t csB,
+                  float* c, size_t ldc, size_t strideC);
+
+// Aktuell verwendeter Kernel
+Kernel activeKernel();
+
+// Kernel erzwingen (z.B. für Vergleiche); nicht unterstützte Kernel werfen
+void setKernel(Kernel kernel);
+
+// Automatische Auswahl wiederherstellen
+void resetKernel();
+
+bool isSupported(Kernel kernel);
+const char* kernelName(Kernel kernel);
+
+} // namespace gemm
+} // namespace tensor
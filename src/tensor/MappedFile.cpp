@@ -0,0 +1,297 @@
+#include "tensor/MappedFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tensor {
+
+namespace {
+
+constexpr uint64_t FILE_MAGIC = 0x3150414D52534E54ull;  // "TNSRMAP1"
+
+// Daten beginnen auf einer Seitengrenze (und damit 64-Byte-ausgerichtet)
+constexpr uint64_t DATA_OFFSET = 4096;
+
+struct FileHeader {
+    uint64_t magic;
+    uint64_t dataOffset;
+    uint8_t dtype;
+    uint8_t rank;
+    uint8_t reserved[6];
+    uint64_t shape[Shape::MAX_RANK];
+};
+static_assert(sizeof(FileHeader) <= DATA_OFFSET, "header must fit before the data");
+
+// Große Tensoren in Stücken schreiben (Grenzen einzelner write-Aufrufe)
+constexpr size_t WRITE_CHUNK = size_t(64) << 20;
+
+// Kopf einer Tensor-Datei, auf DATA_OFFSET Bytes aufgefüllt
+std::vector<char> makeHeader(const Shape& shape, DType dtype) {
+    FileHeader header = {};
+    header.magic = FILE_MAGIC;
+    header.dataOffset = DATA_OFFSET;
+    header.dtype = static_cast<uint8_t>(dtype);
+    header.rank = static_cast<uint8_t>(shape.size());
+    for (size_t i = 0; i < shape.size(); ++i) header.shape[i] = shape[i];
+
+    std::vector<char> bytes(DATA_OFFSET, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    return bytes;
+}
+
+size_t pageSize() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#endif
+}
+
+} // namespace
+
+// === Abbilden ===
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& path, MapMode mode) {
+    return map(path, mode == MapMode::CopyOnWrite, false);
+}
+
+std::shared_ptr<MappedFile> MappedFile::map(const std::string& path, bool writable, bool shared) {
+    std::shared_ptr<MappedFile> file(new MappedFile(path, writable, shared));
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(path.c_str(), shared ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                                FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(handle, &size);
+    file->size_ = static_cast<size_t>(size.QuadPart);
+    if (file->size_ > 0) {
+        const DWORD protect = shared ? PAGE_READWRITE : writable ? PAGE_WRITECOPY : PAGE_READONLY;
+        const DWORD access = shared ? FILE_MAP_WRITE : writable ? FILE_MAP_COPY : FILE_MAP_READ;
+        file->mapping_ = CreateFileMappingA(handle, nullptr, protect, 0, 0, nullptr);
+        if (file->mapping_) {
+            file->data_ = static_cast<char*>(MapViewOfFile(file->mapping_, access, 0, 0, 0));
+        }
+    }
+    CloseHandle(handle);
+#else
+    int fd = ::open(path.c_str(), shared ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    file->size_ = static_cast<size_t>(info.st_size);
+    if (file->size_ > 0) {
+        // CopyOnWrite (privat + PROT_WRITE): Schreiben erzeugt anonyme Kopien
+        // einzelner Seiten, die Datei bleibt unberührt; create(): geteilt
+        void* ptr = mmap(nullptr, file->size_, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                         writable && !shared ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+        file->data_ = ptr == MAP_FAILED ? nullptr : static_cast<char*>(ptr);
+    }
+    // Die Abbildung bleibt ohne den Deskriptor gültig
+    ::close(fd);
+#endif
+
+    if (file->size_ > 0 && !file->data_) {
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    return file;
+}
+
+std::shared_ptr<MappedFile> MappedFile::create(const std::string& path, const Shape& shape, DType dtype) {
+    size_t size = 1;
+    for (size_t d : shape) size *= d;
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        std::vector<char> header = makeHeader(shape, dtype);
+        file.write(header.data(), header.size());
+        if (!file) {
+            throw std::runtime_error("Cannot create file: " + path);
+        }
+    }
+    // Vergrößern ohne zu schreiben: der Rest liest sich als Nullen
+    std::error_code error;
+    std::filesystem::resize_file(path, DATA_OFFSET + size * dtypeSize(dtype), error);
+    if (error) {
+        throw std::runtime_error("Cannot resize file: " + path);
+    }
+    return map(path, true, true);
+}
+
+MappedFile::~MappedFile() {
+#if defined(_WIN32)
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+#else
+    if (data_) munmap(data_, size_);
+#endif
+}
+
+void MappedFile::advise(MapAdvice advice, size_t offset, size_t length) const {
+    if (!data_ || offset >= size_) return;
+    if (length == 0 || length > size_ - offset) length = size_ - offset;
+
+#if defined(_WIN32)
+    // Windows kennt nur Vorladen; die übrigen Hinweise entfallen
+    if (advice == MapAdvice::WillNeed) {
+        WIN32_MEMORY_RANGE_ENTRY range = {data_ + offset, length};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    // madvise verlangt eine Seitengrenze als Anfang
+    const size_t start = offset - offset % pageSize();
+    int flag = MADV_NORMAL;
+    switch (advice) {
+        case MapAdvice::Normal: flag = MADV_NORMAL; break;
+        case MapAdvice::Sequential: flag = MADV_SEQUENTIAL; break;
+        case MapAdvice::Random: flag = MADV_RANDOM; break;
+        case MapAdvice::WillNeed: flag = MADV_WILLNEED; break;
+    }
+    // Nur ein Hinweis; Fehler sind harmlos
+    madvise(data_ + start, length + (offset - start), flag);
+#endif
+}
+
+std::shared_ptr<Storage> MappedFile::storage(DType dtype) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::weak_ptr<Storage>& slot = storages_[dtype];
+    std::shared_ptr<Storage> storage = slot.lock();
+    if (!storage) {
+        storage = std::make_shared<Storage>(shared_from_this(), data_, size_ / dtypeSize(dtype), dtype,
+                                            writable_, shared_ || !writable_);
+        slot = storage;
+    }
+    return storage;
+}
+
+Tensor MappedFile::tensor(const Shape& shape, DType dtype, size_t byteOffset) {
+    Tensor t;
+    t.validateShape(shape);
+    t.shape_ = shape;
+    t.computeStrides();
+    t.size_ = shape.empty() ? 1 : t.strides_[0] * shape[0];
+
+    const size_t itemSize = dtypeSize(dtype);
+    if (byteOffset % itemSize != 0) {
+        throw std::invalid_argument("Mapped tensor offset must be a multiple of the element size");
+    }
+    if (byteOffset > size_ || t.size_ > (size_ - byteOffset) / itemSize) {
+        throw std::out_of_range("Mapped tensor " + t.shapeString() + " exceeds file " + path_);
+    }
+
+    t.storage_ = storage(dtype);
+    t.offset_ = byteOffset / itemSize;
+    t.updateContiguous();
+    return t;
+}
+
+void MappedFile::load(const Tensor& tensor, size_t first, size_t count) {
+    if (!tensor.isMapped() || !tensor.isContiguous() || first >= tensor.size()) return;
+    count = std::min(count, tensor.size() - first);
+
+    const size_t page = pageSize();
+    const char* begin = tensor.rawBase() + first * tensor.itemSize();
+    const char* end = begin + count * tensor.itemSize();
+#if defined(_WIN32)
+    WIN32_MEMORY_RANGE_ENTRY range = {const_cast<char*>(begin), static_cast<size_t>(end - begin)};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    const uintptr_t start = reinterpret_cast<uintptr_t>(begin) & ~uintptr_t(page - 1);
+    madvise(reinterpret_cast<void*>(start), static_cast<size_t>(reinterpret_cast<uintptr_t>(end) - start),
+            MADV_WILLNEED);
+#endif
+    // Ein Byte je Seite lesen: danach sind alle Seiten sicher eingelagert
+    volatile char sink = 0;
+    for (const char* p = begin; p < end; p += page) sink = sink + *p;
+    sink = sink + *(end - 1);
+}
+
+void MappedFile::release(const Tensor& tensor, size_t first, size_t count) {
+    if (!tensor.isMapped() || !tensor.isContiguous() || first >= tensor.size()) return;
+    if (!tensor.storage_->reloadable()) return;
+    count = std::min(count, tensor.size() - first);
+
+    // Seiten, die in den Bereich hineinragen, gehören zum Bereich; die
+    // letzte angeschnittene Seite gibt erst der folgende Bereich frei
+    const uintptr_t page = pageSize();
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(tensor.rawBase() + first * tensor.itemSize());
+    uintptr_t end = begin + count * tensor.itemSize();
+    end = first + count == tensor.size() ? (end + page - 1) & ~(page - 1) : end & ~(page - 1);
+    const uintptr_t start = begin & ~(page - 1);
+    if (end <= start) return;
+#if defined(_WIN32)
+    // Entfernt nicht gesperrte Seiten aus dem Working Set
+    VirtualUnlock(reinterpret_cast<void*>(start), end - start);
+#else
+    // Geteilte Abbildung: geänderte Seiten bleiben im Page-Cache und
+    // werden in die Datei geschrieben, nur die Zuordnung entfällt
+    madvise(reinterpret_cast<void*>(start), end - start, MADV_DONTNEED);
+#endif
+}
+
+// === Tensor-Dateien mit Kopf ===
+
+bool MappedFile::save(const Tensor& tensor, const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    std::vector<char> header = makeHeader(tensor.shape(), tensor.dtype());
+    file.write(header.data(), header.size());
+
+    // Views werden einmal zusammenhängend kopiert, sonst direkt geschrieben
+    const Tensor src = tensor.contiguous();
+    if (src.size_ > 0 && src.storage_) {
+        const char* bytes = src.rawBase();
+        for (size_t done = 0; done < src.nbytes(); done += WRITE_CHUNK) {
+            file.write(bytes + done, static_cast<std::streamsize>(std::min(WRITE_CHUNK, src.nbytes() - done)));
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+Tensor MappedFile::tensor() {
+    FileHeader header;
+    if (size_ < DATA_OFFSET) {
+        throw std::invalid_argument("Not a mapped tensor file: " + path_);
+    }
+    std::memcpy(&header, data_, sizeof(header));
+    if (header.magic != FILE_MAGIC || header.rank > Shape::MAX_RANK ||
+        header.dtype > static_cast<uint8_t>(DType::Int8) || header.dataOffset % Allocator::ALIGNMENT != 0) {
+        throw std::invalid_argument("Not a mapped tensor file: " + path_);
+    }
+
+    Shape shape(header.rank);
+    for (size_t i = 0; i < header.rank; ++i) shape[i] = static_cast<size_t>(header.shape[i]);
+    return tensor(shape, static_cast<DType>(header.dtype), static_cast<size_t>(header.dataOffset));
+}
+
+Tensor mapTensor(const std::string& path, MapMode mode, MapAdvice advice) {
+    auto file = MappedFile::open(path, mode);
+    file->advise(advice);
+    return file->tensor();
+}
+
+} // namespace tensor
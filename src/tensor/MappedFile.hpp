@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+
+enum class MapMode : uint8_t {
+    ReadOnly,     // Schreiben kopiert den Tensor zuerst auf den Heap
+    CopyOnWrite   // privat: Änderungen bleiben im Prozess, nie in der Datei
+};
+
+// Zugriffsmuster als Hinweis ans Betriebssystem (madvise)
+enum class MapAdvice : uint8_t {
+    Normal,
+    Sequential,   // aggressiv vorauslesen, gelesene Seiten früh verdrängen
+    Random,       // kein Vorauslesen (z.B. Embedding-Lookups)
+    WillNeed      // Seiten jetzt im Hintergrund einlesen
+};
+
+/**
+ * @brief In den Adressraum abgebildete Datei als Tensor-Speicher
+ *
+ * Tensoren aus tensor() lesen direkt aus der Abbildung; das Betriebssystem
+ * lädt Seiten erst beim ersten Zugriff und kann sie jederzeit wieder
+ * verdrängen. So lassen sich Dateien öffnen, die größer als der
+ * Arbeitsspeicher sind. Alle lesenden Operationen funktionieren
+ * unverändert; schreibende kopieren bei ReadOnly vorher (Copy-on-Write
+ * wie bei geteiltem Storage).
+ *
+ * Alle Tensoren eines dtype teilen sich einen Storage über die ganze
+ * Datei, sind also Views darauf: Bei CopyOnWrite schreibt ein Tensor nur
+ * dann direkt in die (private) Abbildung, wenn er sie allein nutzt, sonst
+ * kopiert er wie gewohnt. Die Abbildung lebt, solange ein Tensor darauf zeigt.
+ */
+class MappedFile : public std::enable_shared_from_this<MappedFile> {
+public:
+    // Wirft std::runtime_error, wenn die Datei nicht abgebildet werden kann
+    static std::shared_ptr<MappedFile> open(const std::string& path, MapMode mode = MapMode::ReadOnly);
+
+    // Neue Tensor-Datei (Format wie save()) mit shape und dtype anlegen und
+    // geteilt abbilden; tensor() liefert den Inhalt (Nullen). Die Daten
+    // belegen erst beim Schreiben Platz auf der Platte. Gedacht als Ziel
+    // für Stream::assign: Schreibzugriffe landen nur dann in der Datei,
+    // wenn der Tensor die Abbildung allein nutzt. Gibt es weitere Views
+    // darauf, kopiert er wie sonst auch zuerst (Copy-on-Write) und die
+    // Änderung erreicht die Datei nicht.
+    static std::shared_ptr<MappedFile> create(const std::string& path, const Shape& shape,
+                                              DType dtype = DType::Float32);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::string& path() const { return path_; }
+    // Beschreibbar (CopyOnWrite oder create()); shared: Änderungen gehen in
+    // die Datei (nur create())
+    bool writable() const { return writable_; }
+    bool shared() const { return shared_; }
+    size_t size() const { return size_; }
+    const char* data() const { return data_; }
+
+    // Tensor über die Bytes ab byteOffset (muss durch die Elementgröße
+    // teilbar sein und vollständig in der Datei liegen)
+    Tensor tensor(const Shape& shape, DType dtype = DType::Float32, size_t byteOffset = 0);
+
+    // Hinweis für [offset, offset + length); length 0 = bis zum Ende
+    void advise(MapAdvice advice, size_t offset = 0, size_t length = 0) const;
+
+    // Elemente [first, first + count) eines zusammenhängenden, gemappten
+    // Tensors einlesen (kehrt erst zurück, wenn die Seiten da sind) bzw.
+    // aus dem Arbeitsspeicher verdrängen. Verdrängt wird nur, was aus der
+    // Datei neu geladen werden kann (nicht bei CopyOnWrite); für andere
+    // Tensoren ohne Wirkung.
+    static void load(const Tensor& tensor, size_t first, size_t count);
+    static void release(const Tensor& tensor, size_t first, size_t count);
+
+    // === Tensor-Dateien mit Kopf ===
+    // Kopf mit dtype und Shape, Daten seitenweise ausgerichtet dahinter
+
+    static bool save(const Tensor& tensor, const std::string& path);
+    Tensor tensor();
+
+private:
+    MappedFile(std::string path, bool writable, bool shared)
+        : path_(std::move(path)), writable_(writable), shared_(shared) {}
+
+    static std::shared_ptr<MappedFile> map(const std::string& path, bool writable, bool shared);
+
+    std::shared_ptr<Storage> storage(DType dtype);
+
+    std::string path_;
+    bool writable_;
+    bool shared_;
+    char* data_ = nullptr;
+    size_t size_ = 0;
+
+    std::mutex mutex_;
+    std::map<DType, std::weak_ptr<Storage>> storages_;
+#ifdef _WIN32
+    void* mapping_ = nullptr;
+#endif
+};
+
+// Datei von MappedFile::save öffnen und als Tensor abbilden
+Tensor mapTensor(const std::string& path, MapMode mode = MapMode::ReadOnly,
+                 MapAdvice advice = MapAdvice::Normal);
+
+} // namespace tensor
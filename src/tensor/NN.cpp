@@ -0,0 +1,250 @@
+#include "tensor/NN.hpp"
+#include "tensor/Gemm.hpp"
+#include "tensor/Reduce.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/VectorMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tensor {
+
+namespace {
+
+// Zeilen in L1-freundlichen Stücken: exp und Summe auf demselben Block
+constexpr size_t BLOCK = 256;
+
+// Softmax einer zusammenhängenden Zeile; out darf gleich in sein
+void softmaxRow(const float* in, float* out, size_t n, bool log) {
+    const float m = reduce::max(in, n);
+    alignas(64) float tmp[BLOCK];
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i += BLOCK) {
+        size_t len = std::min(BLOCK, n - i);
+        float* e = log ? tmp : out + i;
+        for (size_t k = 0; k < len; ++k) e[k] = in[i + k] - m;
+        vmath::exp(e, e, len);
+        sum += reduce::sum(e, len);
+    }
+    if (log) {
+        const float shift = m + std::log(sum);
+        for (size_t k = 0; k < n; ++k) out[k] = in[k] - shift;
+    } else {
+        const float scale = 1.0f / sum;
+        for (size_t k = 0; k < n; ++k) out[k] *= scale;
+    }
+}
+
+// Softmax über die mittlere Achse eines (n, inner)-Blocks, spaltenweise
+// für alle inner Spalten gleichzeitig; out != in
+void softmaxColumns(const float* in, float* out, size_t n, size_t inner, bool log,
+                    float* mx, float* sum) {
+    std::fill(mx, mx + inner, -std::numeric_limits<float>::infinity());
+    std::fill(sum, sum + inner, 0.0f);
+    for (size_t r = 0; r < n; ++r) {
+        const float* row = in + r * inner;
+        for (size_t j = 0; j < inner; ++j) mx[j] = std::max(mx[j], row[j]);
+    }
+    for (size_t r = 0; r < n; ++r) {
+        const float* row = in + r * inner;
+        float* d = out + r * inner;
+        for (size_t j = 0; j < inner; ++j) d[j] = row[j] - mx[j];
+        vmath::exp(d, d, inner);
+        for (size_t j = 0; j < inner; ++j) sum[j] += d[j];
+    }
+    if (log) {
+        for (size_t j = 0; j < inner; ++j) mx[j] += std::log(sum[j]);
+        for (size_t r = 0; r < n; ++r) {
+            const float* row = in + r * inner;
+            float* d = out + r * inner;
+            for (size_t j = 0; j < inner; ++j) d[j] = row[j] - mx[j];
+        }
+    } else {
+        for (size_t j = 0; j < inner; ++j) sum[j] = 1.0f / sum[j];
+        for (size_t r = 0; r < n; ++r) {
+            float* d = out + r * inner;
+            for (size_t j = 0; j < inner; ++j) d[j] *= sum[j];
+        }
+    }
+}
+
+Tensor softmaxImpl(const Tensor& x, size_t axis, bool log) {
+    if (axis >= x.rank()) {
+        throw std::out_of_range(std::string(log ? "logSoftmax" : "softmax") + ": axis out of range");
+    }
+    const Tensor src = x.to(DType::Float32).contiguous();
+    Tensor result(src.shape());
+    const float* in = src.data();
+    float* out = result.data();
+
+    size_t n = src.shape()[axis];
+    size_t inner = 1;
+    for (size_t d = axis + 1; d < src.rank(); ++d) inner *= src.shape()[d];
+    size_t outer = src.size() / (n * inner);
+
+    if (inner == 1) {
+        parallel_for(0, outer, rowsPerTask(n), [=](size_t begin, size_t end) {
+            for (size_t o = begin; o < end; ++o) softmaxRow(in + o * n, out + o * n, n, log);
+        });
+        return result;
+    }
+
+    parallel_for(0, outer, rowsPerTask(n * inner), [=](size_t begin, size_t end) {
+        std::vector<float> mx(inner), sum(inner);
+        for (size_t o = begin; o < end; ++o) {
+            softmaxColumns(in + o * n * inner, out + o * n * inner, n, inner, log,
+                           mx.data(), sum.data());
+        }
+    });
+    return result;
+}
+
+// Ctx des GEMM-Epilogs von linear()
+struct LinearEpilogue {
+    const float* bias;
+    Activation activation;
+};
+
+void biasActivation(const void* ctx, float* c, size_t ldc, size_t rows, size_t cols,
+                    size_t, size_t col0) {
+    const auto& e = *static_cast<const LinearEpilogue*>(ctx);
+    for (size_t i = 0; i < rows; ++i) {
+        float* row = c + i * ldc;
+        if (e.bias) {
+            const float* b = e.bias + col0;
+            for (size_t j = 0; j < cols; ++j) row[j] += b[j];
+        }
+        activate(e.activation, row, cols);
+    }
+}
+
+void checkVector(const Tensor& t, size_t n, const char* what, const char* op) {
+    if (!t.empty() && (t.rank() != 1 || t.size() != n)) {
+        throw std::invalid_argument(std::string(op) + ": " + what + " must have " +
+                                    std::to_string(n) + " values, got " + t.shapeString());
+    }
+}
+
+} // namespace
+
+void activate(Activation activation, float* x, size_t n) {
+    switch (activation) {
+        case Activation::ReLU:
+            for (size_t i = 0; i < n; ++i) x[i] = x[i] < 0.0f ? 0.0f : x[i];
+            break;
+        case Activation::Sigmoid:
+            vmath::sigmoid(x, x, n);
+            break;
+        case Activation::Tanh:
+            vmath::tanh(x, x, n);
+            break;
+        case Activation::GELU:
+            vmath::gelu(x, x, n);
+            break;
+        default:
+            break;
+    }
+}
+
+Tensor softmax(const Tensor& x) {
+    return softmax(x, x.rank() ? x.rank() - 1 : 0);
+}
+
+Tensor softmax(const Tensor& x, size_t axis) {
+    return softmaxImpl(x, axis, false);
+}
+
+Tensor logSoftmax(const Tensor& x) {
+    return logSoftmax(x, x.rank() ? x.rank() - 1 : 0);
+}
+
+Tensor logSoftmax(const Tensor& x, size_t axis) {
+    return softmaxImpl(x, axis, true);
+}
+
+Tensor layerNorm(const Tensor& x, const Tensor& gamma, const Tensor& beta, float eps) {
+    if (x.rank() == 0) {
+        throw std::invalid_argument("layerNorm expects at least 1D input");
+    }
+    size_t n = x.shape().back();
+    checkVector(gamma, n, "gamma", "layerNorm");
+    checkVector(beta, n, "beta", "layerNorm");
+
+    const Tensor src = x.to(DType::Float32).contiguous();
+    const Tensor g = gamma.empty() ? Tensor() : gamma.to(DType::Float32).contiguous();
+    const Tensor b = beta.empty() ? Tensor() : beta.to(DType::Float32).contiguous();
+    Tensor result(src.shape());
+    const float* in = src.data();
+    const float* gv = gamma.empty() ? nullptr : g.data();
+    const float* bv = beta.empty() ? nullptr : b.data();
+    float* out = result.data();
+
+    // Zentrieren, Varianz aus den zentrierten Werten (zwei Durchläufe über
+    // die Zeile im L1 statt E[x^2] - E[x]^2 mit Auslöschung)
+    parallel_for(0, src.size() / n, rowsPerTask(n), [=](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            const float* row = in + r * n;
+            float* d = out + r * n;
+            const float mean = reduce::sum(row, n) / static_cast<float>(n);
+            for (size_t k = 0; k < n; ++k) d[k] = row[k] - mean;
+            float sq[8] = {};
+            size_t k = 0;
+            for (; k + 8 <= n; k += 8) {
+                for (size_t l = 0; l < 8; ++l) sq[l] += d[k + l] * d[k + l];
+            }
+            for (; k < n; ++k) sq[0] += d[k] * d[k];
+            float var = ((sq[0] + sq[1]) + (sq[2] + sq[3])) + ((sq[4] + sq[5]) + (sq[6] + sq[7]));
+            const float rstd = 1.0f / std::sqrt(var / static_cast<float>(n) + eps);
+            if (gv && bv) {
+                for (size_t j = 0; j < n; ++j) d[j] = d[j] * rstd * gv[j] + bv[j];
+            } else if (gv) {
+                for (size_t j = 0; j < n; ++j) d[j] = d[j] * rstd * gv[j];
+            } else {
+                for (size_t j = 0; j < n; ++j) d[j] *= rstd;
+                if (bv) {
+                    for (size_t j = 0; j < n; ++j) d[j] += bv[j];
+                }
+            }
+        }
+    });
+    return result;
+}
+
+Tensor linear(const Tensor& x, const Tensor& weight, const Tensor& bias, Activation activation) {
+    if (weight.rank() != 2) {
+        throw std::invalid_argument("linear expects a 2D weight (in, out), got " + weight.shapeString());
+    }
+    size_t in = weight.shape()[0];
+    size_t out = weight.shape()[1];
+    if (x.rank() == 0 || x.shape().back() != in) {
+        throw std::invalid_argument("linear: input " + x.shapeString() +
+                                    " does not match weight " + weight.shapeString());
+    }
+    checkVector(bias, out, "bias", "linear");
+
+    const Tensor a = x.to(DType::Float32).contiguous();
+    const Tensor w = weight.to(DType::Float32);
+    const Tensor b = bias.empty() ? Tensor() : bias.to(DType::Float32).contiguous();
+
+    Tensor::Shape shape = x.shape();
+    shape.back() = out;
+    Tensor result(shape);
+
+    LinearEpilogue ctx{bias.empty() ? nullptr : b.data(), activation};
+    gemm::Epilogue epilogue;
+    if (ctx.bias || activation != Activation::None) {
+        epilogue.fn = &biasActivation;
+        epilogue.ctx = &ctx;
+    }
+    gemm::sgemm(a.size() / in, out, in,
+                a.data(), in, 1,
+                w.data(), w.strides()[0], w.strides()[1],
+                result.data(), out, false, epilogue);
+    return result;
+}
+
+} // namespace tensor
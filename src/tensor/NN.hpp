@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+
+// Aktivierung einer Schicht (linear) bzw. für activate()
+enum class Activation {
+    None,
+    ReLU,
+    Sigmoid,
+    Tanh,
+    GELU  // Tanh-Näherung
+};
+
+// Aktivierung in-place auf n zusammenhängende Werte (vektorisiert)
+void activate(Activation activation, float* x, size_t n);
+
+// === Elementweise Aktivierungen ===
+
+// Lazy wie x.relu() usw.: relu(a.matmul(W) + b) wertet in einem Durchlauf aus
+template <typename T, typename = std::enable_if_t<expr::isOperand<T>>>
+auto relu(T&& x) { return expr::node(std::forward<T>(x)).relu(); }
+
+template <typename T, typename = std::enable_if_t<expr::isOperand<T>>>
+auto sigmoid(T&& x) { return expr::node(std::forward<T>(x)).sigmoid(); }
+
+template <typename T, typename = std::enable_if_t<expr::isOperand<T>>>
+auto tanh(T&& x) { return expr::node(std::forward<T>(x)).tanh(); }
+
+template <typename T, typename = std::enable_if_t<expr::isOperand<T>>>
+auto gelu(T&& x) { return expr::node(std::forward<T>(x)).gelu(); }
+
+// === Normierungen ===
+
+/**
+ * @brief Softmax entlang einer Achse (Standard: letzte)
+ *
+ * Numerisch stabil: pro Zeile wird erst das Maximum gesucht, dann in
+ * einem Durchlauf exp(x - max) geschrieben und aufsummiert, zuletzt
+ * skaliert. Große Werte laufen so nie über. Ergebnis float32.
+ */
+Tensor softmax(const Tensor& x);
+Tensor softmax(const Tensor& x, size_t axis);
+
+// log(softmax(x)) = x - max - log(sum(exp(x - max))), ohne log(0)
+Tensor logSoftmax(const Tensor& x);
+Tensor logSoftmax(const Tensor& x, size_t axis);
+
+/**
+ * @brief Layer-Normalisierung über die letzte Achse
+ *
+ * y = (x - mean) / sqrt(var + eps) * gamma + beta pro Zeile; gamma und
+ * beta sind leer oder haben so viele Werte wie die letzte Achse.
+ */
+Tensor layerNorm(const Tensor& x, const Tensor& gamma = Tensor(), const Tensor& beta = Tensor(),
+                 float eps = 1e-5f);
+
+/**
+ * @brief Dense-Schicht: activation(x @ weight + bias)
+ *
+ * x hat die Form (..., in), weight (in, out) wie in Lektion 6, bias ist
+ * leer oder hat out Werte. Bias und Aktivierung laufen im Epilog der
+ * GEMM, solange die Ausgabekachel noch im Cache liegt - ohne weiteren
+ * Durchlauf über das Ergebnis. weight darf eine View sein (z.B.
+ * transponiert), sie wird nicht kopiert. Ergebnis float32.
+ */
+Tensor linear(const Tensor& x, const Tensor& weight, const Tensor& bias = Tensor(),
+              Activation activation = Activation::None);
+
+} // namespace tensor
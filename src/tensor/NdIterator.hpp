@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "tensor/Shape.hpp"
+
+namespace tensor {
+
+/**
+ * @brief Zähler (Odometer) über alle Indizes einer Shape
+ *
+ * Läuft in zeilenweiser Reihenfolge und führt für N Operanden mit eigenen
+ * Strides (z.B. Quelle, Ziel und gebroadcasteter Operand) die Position mit.
+ * next() erhöht die letzte Achse und trägt Überläufe nach vorne weiter,
+ * ganz ohne Division; nur der Start an einer beliebigen flachen Position
+ * teilt einmal pro Achse. Damit lässt sich ein Bereich in parallele
+ * Teilbereiche zerlegen:
+ *
+ *     parallel_for(0, n, 0, [&](size_t begin, size_t end) {
+ *         NdIterator<2> it(shape, {a.strides(), b.strides()}, begin);
+ *         for (size_t i = begin; i < end; ++i, it.next()) {
+ *             out[i] = pa[it.offset(0)] + pb[it.offset(1)];
+ *         }
+ *     });
+ *
+ * Strides dürfen länger als die Shape sein (z.B. nur die Batch-Achsen
+ * einer Matrix durchlaufen); verwendet werden die ersten shape.size().
+ */
+template <size_t N = 0>
+class NdIterator {
+public:
+    // Nur Indizes, ohne Operanden
+    explicit NdIterator(const Shape& shape, size_t start = 0)
+        : NdIterator(shape, std::array<Shape, N>{}, start) {
+        static_assert(N == 0, "NdIterator with operands needs their strides");
+    }
+
+    NdIterator(const Shape& shape, const std::array<Shape, N>& strides, size_t start = 0)
+        : shape_(shape), strides_(strides), index_(shape.size(), 0) {
+        size_ = 1;
+        for (size_t d : shape_) size_ *= d;
+        seek(start);
+    }
+
+    // An die flache (zeilenweise) Position flat springen
+    void seek(size_t flat) {
+        flat_ = flat;
+        offsets_.fill(0);
+        for (size_t d = shape_.size(); d-- > 0;) {
+            index_[d] = flat % shape_[d];
+            flat /= shape_[d];
+            for (size_t k = 0; k < N; ++k) offsets_[k] += index_[d] * strides_[k][d];
+        }
+    }
+
+    void next() {
+        ++flat_;
+        for (size_t d = shape_.size(); d-- > 0;) {
+            for (size_t k = 0; k < N; ++k) offsets_[k] += strides_[k][d];
+            if (++index_[d] < shape_[d]) return;
+            for (size_t k = 0; k < N; ++k) offsets_[k] -= shape_[d] * strides_[k][d];
+            index_[d] = 0;
+        }
+    }
+
+    NdIterator& operator++() {
+        next();
+        return *this;
+    }
+
+    bool done() const { return flat_ >= size_; }
+
+    const Shape& index() const { return index_; }
+    size_t operator[](size_t axis) const { return index_[axis]; }
+
+    // Position im Speicher von Operand k (in Elementen, Strides beachtet)
+    size_t offset(size_t k = 0) const { return offsets_[k]; }
+
+    // Laufende Nummer in zeilenweiser Reihenfolge
+    size_t flat() const { return flat_; }
+    size_t size() const { return size_; }
+    const Shape& shape() const { return shape_; }
+
+private:
+    Shape shape_;
+    std::array<Shape, N> strides_;
+    Shape index_;
+    std::array<size_t, N> offsets_{};
+    size_t flat_ = 0;
+    size_t size_ = 1;
+};
+
+} // namespace tensor
@@ -0,0 +1,285 @@
+#include "tensor/Permute.hpp"
+#include "tensor/NdIterator.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/Simd.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace tensor {
+namespace permute {
+
+namespace {
+
+// Kachelkante in Elementen: Quell- und Zielkachel (je 16 KB bei float)
+// bleiben zusammen im L1
+constexpr size_t TILE = 64;
+
+bool useAvx() {
+    static const bool avx = simd::cpu().avx;
+    return avx;
+}
+
+// === Kacheln ===
+
+template <typename T>
+void tileScalar(const T* src, size_t lda, T* dst, size_t ldb, size_t rows, size_t cols) {
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) dst[j * ldb + i] = src[i * lda + j];
+    }
+}
+
+#if TENSOR_X86
+
+TENSOR_TARGET("sse2")
+void block4x4Sse(const float* src, size_t lda, float* dst, size_t ldb) {
+    __m128 r0 = _mm_loadu_ps(src);
+    __m128 r1 = _mm_loadu_ps(src + lda);
+    __m128 r2 = _mm_loadu_ps(src + 2 * lda);
+    __m128 r3 = _mm_loadu_ps(src + 3 * lda);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + ldb, r1);
+    _mm_storeu_ps(dst + 2 * ldb, r2);
+    _mm_storeu_ps(dst + 3 * ldb, r3);
+}
+
+TENSOR_TARGET("avx")
+void block8x8Avx(const float* src, size_t lda, float* dst, size_t ldb) {
+    __m256 r0 = _mm256_loadu_ps(src);
+    __m256 r1 = _mm256_loadu_ps(src + lda);
+    __m256 r2 = _mm256_loadu_ps(src + 2 * lda);
+    __m256 r3 = _mm256_loadu_ps(src + 3 * lda);
+    __m256 r4 = _mm256_loadu_ps(src + 4 * lda);
+    __m256 r5 = _mm256_loadu_ps(src + 5 * lda);
+    __m256 r6 = _mm256_loadu_ps(src + 6 * lda);
+    __m256 r7 = _mm256_loadu_ps(src + 7 * lda);
+
+    // Paare verschränken, dann Viererblöcke, zuletzt die 128-Bit-Hälften
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(dst, _mm256_permute2f128_ps(s0, s4, 0x20));
+    _mm256_storeu_ps(dst + ldb, _mm256_permute2f128_ps(s1, s5, 0x20));
+    _mm256_storeu_ps(dst + 2 * ldb, _mm256_permute2f128_ps(s2, s6, 0x20));
+    _mm256_storeu_ps(dst + 3 * ldb, _mm256_permute2f128_ps(s3, s7, 0x20));
+    _mm256_storeu_ps(dst + 4 * ldb, _mm256_permute2f128_ps(s0, s4, 0x31));
+    _mm256_storeu_ps(dst + 5 * ldb, _mm256_permute2f128_ps(s1, s5, 0x31));
+    _mm256_storeu_ps(dst + 6 * ldb, _mm256_permute2f128_ps(s2, s6, 0x31));
+    _mm256_storeu_ps(dst + 7 * ldb, _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+
+// Kachel aus B x B Blöcken, Ränder skalar; Bits werden nur verschoben,
+// daher auch für int32. Zielzeilen außen: jede Zielzeile der Kachel wird
+// am Stück vollständig geschrieben, bevor die nächsten drankommen
+template <size_t B, void (*Block)(const float*, size_t, float*, size_t)>
+void tileBlocked(const float* src, size_t lda, float* dst, size_t ldb, size_t rows, size_t cols) {
+    size_t fullRows = rows / B * B;
+    size_t fullCols = cols / B * B;
+    for (size_t j = 0; j < fullCols; j += B) {
+        for (size_t i = 0; i < fullRows; i += B) {
+            Block(src + i * lda + j, lda, dst + j * ldb + i, ldb);
+        }
+    }
+    tileScalar(src + fullCols, lda, dst + fullCols * ldb, ldb, fullRows, cols - fullCols);
+    tileScalar(src + fullRows * lda, lda, dst + fullRows, ldb, rows - fullRows, cols);
+}
+
+#endif
+
+void tile(const char* src, size_t lda, char* dst, size_t ldb,
+          size_t rows, size_t cols, size_t item) {
+    switch (item) {
+        case 1:
+            tileScalar(reinterpret_cast<const uint8_t*>(src), lda,
+                       reinterpret_cast<uint8_t*>(dst), ldb, rows, cols);
+            break;
+        case 2:
+            tileScalar(reinterpret_cast<const uint16_t*>(src), lda,
+                       reinterpret_cast<uint16_t*>(dst), ldb, rows, cols);
+            break;
+        case 8:
+            tileScalar(reinterpret_cast<const uint64_t*>(src), lda,
+                       reinterpret_cast<uint64_t*>(dst), ldb, rows, cols);
+            break;
+        default: {
+            const float* in = reinterpret_cast<const float*>(src);
+            float* out = reinterpret_cast<float*>(dst);
+#if TENSOR_X86
+            if (useAvx()) {
+                tileBlocked<8, block8x8Avx>(in, lda, out, ldb, rows, cols);
+            } else if (simd::cpu().sse2) {
+                tileBlocked<4, block4x4Sse>(in, lda, out, ldb, rows, cols);
+            } else {
+                tileScalar(in, lda, out, ldb, rows, cols);
+            }
+#else
+            tileScalar(in, lda, out, ldb, rows, cols);
+#endif
+            break;
+        }
+    }
+}
+
+// === Zeilen mit Stride ===
+
+template <typename T>
+void gatherRow(const char* src, char* dst, size_t n, size_t stride) {
+    const T* in = reinterpret_cast<const T*>(src);
+    T* out = reinterpret_cast<T*>(dst);
+    for (size_t j = 0; j < n; ++j) out[j] = in[j * stride];
+}
+
+void gatherRow(const char* src, char* dst, size_t n, size_t stride, size_t item) {
+    switch (item) {
+        case 1: gatherRow<uint8_t>(src, dst, n, stride); break;
+        case 2: gatherRow<uint16_t>(src, dst, n, stride); break;
+        case 8: gatherRow<uint64_t>(src, dst, n, stride); break;
+        default: gatherRow<uint32_t>(src, dst, n, stride); break;
+    }
+}
+
+// Innerste Achse zusammenhängend oder mit Stride: Zeile für Zeile
+void copyRows(const char* src, const Shape& dims, const Shape& steps, char* dst, size_t item) {
+    size_t r = dims.size();
+    size_t inner = dims[r - 1];
+    size_t innerStride = steps[r - 1];
+    size_t outer = 1;
+    for (size_t d = 0; d + 1 < r; ++d) outer *= dims[d];
+
+    if (outer == 1 && innerStride == 1) {
+        parallel_for(0, inner, 0, [=](size_t begin, size_t end) {
+            std::memcpy(dst + begin * item, src + begin * item, (end - begin) * item);
+        });
+        return;
+    }
+
+    Shape outerDims(dims.begin(), dims.end() - 1);
+    size_t grain = std::max<size_t>(1, Scheduler::instance().serialThreshold() / inner);
+    parallel_for(0, outer, grain, [&](size_t begin, size_t end) {
+        NdIterator<1> it(outerDims, {steps}, begin);
+        for (size_t o = begin; o < end; ++o, it.next()) {
+            const char* in = src + it.offset() * item;
+            char* out = dst + o * inner * item;
+            if (innerStride == 1) {
+                std::memcpy(out, in, inner * item);
+            } else {
+                gatherRow(in, out, inner, innerStride, item);
+            }
+        }
+    });
+}
+
+// Achse p zusammenhängend, innerste nicht: für jede Kombination der
+// übrigen Achsen eine Transposition (innerste Achse x Achse p), gekachelt
+void copyTransposed(const char* src, const Shape& dims, const Shape& steps, size_t p,
+                    char* dst, size_t item) {
+    size_t r = dims.size();
+    Shape dstSteps(r);
+    dstSteps[r - 1] = 1;
+    for (size_t d = r - 1; d-- > 0;) dstSteps[d] = dstSteps[d + 1] * dims[d + 1];
+
+    Shape outerDims, outerSteps, outerDstSteps;
+    for (size_t d = 0; d + 1 < r; ++d) {
+        if (d == p) continue;
+        outerDims.push_back(dims[d]);
+        outerSteps.push_back(steps[d]);
+        outerDstSteps.push_back(dstSteps[d]);
+    }
+    size_t outer = 1;
+    for (size_t d : outerDims) outer *= d;
+
+    // Quelle als (rows x cols)-Matrix: Zeilen = innerste Achse, Spalten = Achse p
+    size_t rows = dims[r - 1];
+    size_t cols = dims[p];
+    size_t lda = steps[r - 1];
+    size_t ldb = dstSteps[p];
+    size_t rowTiles = (rows + TILE - 1) / TILE;
+    size_t colTiles = (cols + TILE - 1) / TILE;
+    size_t tilesPerMatrix = rowTiles * colTiles;
+
+    size_t tileElems = std::min(rows, TILE) * std::min(cols, TILE);
+    size_t grain = std::max<size_t>(1, Scheduler::instance().serialThreshold() / tileElems);
+
+    parallel_for(0, outer * tilesPerMatrix, grain, [&](size_t begin, size_t end) {
+        NdIterator<2> it(outerDims, {outerSteps, outerDstSteps}, begin / tilesPerMatrix);
+        for (size_t u = begin; u < end; ++u) {
+            size_t t = u % tilesPerMatrix;
+            if (t == 0 && u != begin) it.next();
+            size_t i0 = (t / colTiles) * TILE;
+            size_t j0 = (t % colTiles) * TILE;
+
+            tile(src + (it.offset(0) + i0 * lda + j0) * item, lda,
+                 dst + (it.offset(1) + j0 * ldb + i0) * item, ldb,
+                 std::min(TILE, rows - i0), std::min(TILE, cols - j0), item);
+        }
+    });
+}
+
+} // namespace
+
+void transpose2d(const void* src, size_t ldSrc, void* dst, size_t ldDst,
+                 size_t rows, size_t cols, size_t item) {
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+    for (size_t i = 0; i < rows; i += TILE) {
+        for (size_t j = 0; j < cols; j += TILE) {
+            tile(in + (i * ldSrc + j) * item, ldSrc, out + (j * ldDst + i) * item, ldDst,
+                 std::min(TILE, rows - i), std::min(TILE, cols - j), item);
+        }
+    }
+}
+
+void copy(const void* src, const Shape& shape, const Shape& strides,
+          void* dst, size_t item) {
+    const char* in = static_cast<const char*>(src);
+    char* out = static_cast<char*>(dst);
+
+    // Achsen der Größe 1 weglassen, im Speicher fortlaufende zusammenlegen
+    // (auch gestreckte Achsen mit Stride 0 hintereinander)
+    Shape dims, steps;
+    for (size_t d = 0; d < shape.size(); ++d) {
+        if (shape[d] == 0) return;
+        if (shape[d] == 1) continue;
+        if (!dims.empty() && steps.back() == strides[d] * shape[d]) {
+            dims.back() *= shape[d];
+            steps.back() = strides[d];
+        } else {
+            dims.push_back(shape[d]);
+            steps.push_back(strides[d]);
+        }
+    }
+    if (dims.empty()) {
+        std::memcpy(out, in, item);
+        return;
+    }
+
+    size_t r = dims.size();
+    if (steps[r - 1] != 1) {
+        for (size_t p = r - 1; p-- > 0;) {
+            if (steps[p] == 1) {
+                copyTransposed(in, dims, steps, p, out, item);
+                return;
+            }
+        }
+    }
+    copyRows(in, dims, steps, out, item);
+}
+
+} // namespace permute
+} // namespace tensor
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include "tensor/Shape.hpp"
+
+namespace tensor {
+namespace permute {
+
+/**
+ * @brief Transponiert eine (rows x cols)-Matrix
+ *
+ * dst[j * ldDst + i] = src[i * ldSrc + j], Strides in Elementen, item
+ * Bytes pro Element (1, 2, 4 oder 8). Gearbeitet wird in Kacheln, die
+ * samt Ziel in den L1-Cache passen; 4-Byte-Elemente werden in 8x8-Blöcken
+ * in AVX-Registern (SSE: 4x4) transponiert. Läuft seriell.
+ */
+void transpose2d(const void* src, size_t ldSrc, void* dst, size_t ldDst,
+                 size_t rows, size_t cols, size_t item);
+
+/**
+ * @brief Kopiert eine View zusammenhängend in zeilenweiser Reihenfolge
+ *
+ * shape/strides beschreiben die View (Strides in Elementen ab src).
+ * Achsen der Größe 1 entfallen, im Quellspeicher aufeinanderfolgende
+ * Achsen werden zusammengelegt. Danach:
+ * - innerste Achse zusammenhängend: zeilenweise memcpy
+ * - eine andere Achse zusammenhängend (Transposition/Permutation):
+ *   gekachelt über transpose2d
+ * - sonst (Stride 0, Schrittweiten): gesammelt mit Stride
+ * Große Kopien laufen parallel.
+ */
+void copy(const void* src, const Shape& shape, const Shape& strides,
+          void* dst, size_t item);
+
+} // namespace permute
+} // namespace tensor
@@ -0,0 +1,340 @@
+#include "tensor/Random.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/Simd.hpp"
+#include "tensor/VectorMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+
+namespace tensor {
+
+namespace {
+
+// Philox4x32-Konstanten (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+constexpr uint32_t M0 = 0xD2511F53u;
+constexpr uint32_t M1 = 0xCD9E8D57u;
+constexpr uint32_t W0 = 0x9E3779B9u;
+constexpr uint32_t W1 = 0xBB67AE85u;
+constexpr int ROUNDS = 10;
+
+// Werte pro Fenster der Rohkernel; Vielfaches von 16, damit Box-Muller
+// immer auf vollen 8er-Gruppen der vmath-Kernel läuft
+constexpr size_t WINDOW = 1024;
+
+constexpr float INV_2_24 = 1.0f / 16777216.0f;
+constexpr float PI = 3.14159265358979f;
+
+bool useAvx2() {
+    static const bool avx2 = simd::cpu().avx2;
+    return avx2;
+}
+
+inline void philoxScalar(uint32_t c[4], uint32_t k0, uint32_t k1) {
+    for (int r = 0; r < ROUNDS; ++r) {
+        uint64_t p0 = uint64_t(M0) * c[0];
+        uint64_t p1 = uint64_t(M1) * c[2];
+        uint32_t n0 = uint32_t(p1 >> 32) ^ c[1] ^ k0;
+        uint32_t n2 = uint32_t(p0 >> 32) ^ c[3] ^ k1;
+        c[1] = uint32_t(p1);
+        c[3] = uint32_t(p0);
+        c[0] = n0;
+        c[2] = n2;
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+#if TENSOR_X86
+
+// Acht Blöcke gleichzeitig; c0..c3 halten je ein Wort der acht Zähler
+TENSOR_TARGET("avx2")
+void philoxAvx2(uint64_t block, uint32_t attempt, uint32_t k0, uint32_t k1, uint32_t* out) {
+    alignas(32) uint32_t lo[8], hi[8];
+    for (int j = 0; j < 8; ++j) {
+        lo[j] = uint32_t(block + j);
+        hi[j] = uint32_t((block + j) >> 32);
+    }
+    __m256i c0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lo));
+    __m256i c1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(hi));
+    __m256i c2 = _mm256_set1_epi32(static_cast<int>(attempt));
+    __m256i c3 = _mm256_setzero_si256();
+    const __m256i m0 = _mm256_set1_epi32(static_cast<int>(M0));
+    const __m256i m1 = _mm256_set1_epi32(static_cast<int>(M1));
+
+    for (int r = 0; r < ROUNDS; ++r) {
+        // 32x32->64 getrennt für gerade und ungerade Lanes
+        __m256i pe0 = _mm256_mul_epu32(c0, m0);
+        __m256i po0 = _mm256_mul_epu32(_mm256_srli_epi64(c0, 32), m0);
+        __m256i pe1 = _mm256_mul_epu32(c2, m1);
+        __m256i po1 = _mm256_mul_epu32(_mm256_srli_epi64(c2, 32), m1);
+        __m256i lo0 = _mm256_blend_epi32(pe0, _mm256_slli_epi64(po0, 32), 0xAA);
+        __m256i hi0 = _mm256_blend_epi32(_mm256_srli_epi64(pe0, 32), po0, 0xAA);
+        __m256i lo1 = _mm256_blend_epi32(pe1, _mm256_slli_epi64(po1, 32), 0xAA);
+        __m256i hi1 = _mm256_blend_epi32(_mm256_srli_epi64(pe1, 32), po1, 0xAA);
+
+        __m256i key0 = _mm256_set1_epi32(static_cast<int>(k0));
+        __m256i key1 = _mm256_set1_epi32(static_cast<int>(k1));
+        c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), key0);
+        c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), key1);
+        c1 = lo1;
+        c3 = lo0;
+        k0 += W0;
+        k1 += W1;
+    }
+
+    // 4x8 -> 8x4: Wörter jedes Blocks wieder hintereinander
+    __m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+    __m256i t1 = _mm256_unpackhi_epi32(c0, c1);
+    __m256i t2 = _mm256_unpacklo_epi32(c2, c3);
+    __m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i* dst = reinterpret_cast<__m256i*>(out);
+    _mm256_storeu_si256(dst + 0, _mm256_permute2x128_si256(u0, u1, 0x20));
+    _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(u2, u3, 0x20));
+    _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(u0, u1, 0x31));
+    _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(u2, u3, 0x31));
+}
+
+#endif
+
+// count Blöcke ab block als 4 * count Wörter
+void philoxBlocks(uint64_t seed, uint64_t block, size_t count, uint32_t attempt, uint32_t* out) {
+    uint32_t k0 = uint32_t(seed);
+    uint32_t k1 = uint32_t(seed >> 32);
+    size_t i = 0;
+#if TENSOR_X86
+    if (useAvx2()) {
+        for (; i + 8 <= count; i += 8) philoxAvx2(block + i, attempt, k0, k1, out + 4 * i);
+    }
+#endif
+    for (; i < count; ++i) {
+        uint64_t b = block + i;
+        uint32_t* c = out + 4 * i;
+        c[0] = uint32_t(b);
+        c[1] = uint32_t(b >> 32);
+        c[2] = attempt;
+        c[3] = 0;
+        philoxScalar(c, k0, k1);
+    }
+}
+
+// Ein Box-Muller-Paar aus zwei Wörtern; u1 in (0, 1], damit log endlich bleibt
+inline void boxMuller(uint32_t a, uint32_t b, float& z0, float& z1) {
+    float u1 = static_cast<float>((a >> 8) + 1) * INV_2_24;
+    float theta = static_cast<float>(b >> 8) * INV_2_24 * (2.0f * PI) - PI;
+    float r = std::sqrt(-2.0f * std::log(u1));
+    z0 = r * std::cos(theta);
+    z1 = r * std::sin(theta);
+}
+
+/**
+ * Läuft in Fenstern über die Werte first .. first + n - 1. Fenster beginnen
+ * an Vielfachen von 16 (absolut im Strom), damit jede Aufteilung dieselben
+ * Rechenwege und damit bitgleiche Ergebnisse liefert. fill(words, len, z)
+ * erhält die Wörter des ganzen Fensters und schreibt len Werte nach z.
+ */
+template <typename Fill>
+void forWindows(float* out, size_t n, uint64_t seed, uint64_t offset, uint64_t first, Fill fill) {
+    alignas(64) uint32_t words[WINDOW];
+    alignas(64) float values[WINDOW];
+    uint64_t pos = first;
+    uint64_t end = first + n;
+    while (pos < end) {
+        uint64_t start = pos & ~uint64_t(15);
+        uint64_t stop = std::min<uint64_t>(start + WINDOW, (end + 15) & ~uint64_t(15));
+        size_t len = static_cast<size_t>(stop - start);
+        philoxBlocks(seed, offset + start / 4, len / 4, 0, words);
+        fill(words, len, values);
+        uint64_t last = std::min(stop, end);
+        std::copy(values + (pos - start), values + (last - start), out + (pos - first));
+        pos = last;
+    }
+}
+
+// Standardnormalverteilte Werte eines Fensters (len Vielfaches von 16)
+void normalWindow(const uint32_t* words, size_t len, float* z) {
+    alignas(64) float r[WINDOW / 2];
+    alignas(64) float theta[WINDOW / 2];
+    alignas(64) float s[WINDOW / 2];
+    size_t pairs = len / 2;
+    for (size_t k = 0; k < pairs; ++k) {
+        r[k] = static_cast<float>((words[2 * k] >> 8) + 1) * INV_2_24;
+        theta[k] = static_cast<float>(words[2 * k + 1] >> 8) * INV_2_24 * (2.0f * PI) - PI;
+    }
+    vmath::log(r, r, pairs);
+    for (size_t k = 0; k < pairs; ++k) r[k] *= -2.0f;
+    vmath::sqrt(r, r, pairs);
+    vmath::sin(theta, s, pairs);
+    vmath::cos(theta, theta, pairs);
+    for (size_t k = 0; k < pairs; ++k) {
+        z[2 * k] = r[k] * theta[k];
+        z[2 * k + 1] = r[k] * s[k];
+    }
+}
+
+uint64_t defaultSeed() {
+    if (const char* env = std::getenv("TENSOR_SEED")) {
+        char* end = nullptr;
+        unsigned long long seed = std::strtoull(env, &end, 10);
+        if (end != env) return seed;
+    }
+    std::random_device rd;
+    return (uint64_t(rd()) << 32) ^ rd();
+}
+
+// Füllt t parallel über den Rohkernel kernel(out, n, first)
+template <typename Kernel>
+Tensor fillParallel(Tensor t, Kernel kernel) {
+    float* out = t.data();
+    parallel_for(0, t.size(), 0, [=](size_t begin, size_t end) {
+        kernel(out + begin, end - begin, begin);
+    });
+    return t;
+}
+
+} // namespace
+
+// === Rohkernel ===
+
+namespace rng {
+
+void philox(uint64_t seed, uint64_t block, uint32_t attempt, uint32_t out[4]) {
+    philoxBlocks(seed, block, 1, attempt, out);
+}
+
+void uniform(float* out, size_t n, float min, float max,
+             uint64_t seed, uint64_t offset, uint64_t first) {
+    const float scale = (max - min) * INV_2_24;
+    // min + u * scale kann für u nahe 1 auf max aufrunden (z.B. [100, 101));
+    // auf den größten Wert unter max begrenzen, damit max ausgeschlossen bleibt
+    const float top = std::nextafter(max, min);
+    const bool clamp = min < max;
+    forWindows(out, n, seed, offset, first, [=](const uint32_t* words, size_t len, float* v) {
+        for (size_t i = 0; i < len; ++i) v[i] = min + static_cast<float>(words[i] >> 8) * scale;
+        if (clamp) {
+            for (size_t i = 0; i < len; ++i) v[i] = std::min(v[i], top);
+        }
+    });
+}
+
+void normal(float* out, size_t n, float mean, float stddev,
+            uint64_t seed, uint64_t offset, uint64_t first) {
+    forWindows(out, n, seed, offset, first, [=](const uint32_t* words, size_t len, float* v) {
+        normalWindow(words, len, v);
+        for (size_t i = 0; i < len; ++i) v[i] = mean + stddev * v[i];
+    });
+}
+
+void truncatedNormal(float* out, size_t n, float mean, float stddev, float bound,
+                     uint64_t seed, uint64_t offset, uint64_t first) {
+    if (!(bound > 0.0f)) {
+        throw std::invalid_argument("truncatedNormal needs a positive bound");
+    }
+    normal(out, n, 0.0f, 1.0f, seed, offset, first);
+    // Ausreißer (bei bound = 2 etwa 4.6 %) einzeln neu ziehen: Versuch k
+    // nutzt Block (offset + i / 4, k), also wieder unabhängig von der Aufteilung
+    for (size_t j = 0; j < n; ++j) {
+        float z = out[j];
+        uint64_t i = first + j;
+        for (uint32_t attempt = 1; !(std::fabs(z) <= bound); ++attempt) {
+            uint32_t w[4];
+            philox(seed, offset + i / 4, attempt, w);
+            size_t pair = (i % 4) / 2;
+            float z0, z1;
+            boxMuller(w[2 * pair], w[2 * pair + 1], z0, z1);
+            z = (i % 2) ? z1 : z0;
+        }
+        out[j] = mean + stddev * z;
+    }
+}
+
+} // namespace rng
+
+// === Generator ===
+
+Generator::Generator(uint64_t seed) : seed_(seed) {}
+
+Generator& Generator::global() {
+    static Generator generator(defaultSeed());
+    return generator;
+}
+
+void Generator::manualSeed(uint64_t seed) {
+    seed_.store(seed, std::memory_order_relaxed);
+    offset_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Generator::reserve(size_t n) {
+    return offset_.fetch_add((n + 3) / 4, std::memory_order_relaxed);
+}
+
+Tensor Generator::uniform(const Shape& shape, float min, float max) {
+    Tensor t = Tensor::uninitialized(shape);
+    uint64_t s = seed(), base = reserve(t.size());
+    return fillParallel(std::move(t), [=](float* out, size_t n, uint64_t first) {
+        rng::uniform(out, n, min, max, s, base, first);
+    });
+}
+
+Tensor Generator::normal(const Shape& shape, float mean, float stddev) {
+    Tensor t = Tensor::uninitialized(shape);
+    uint64_t s = seed(), base = reserve(t.size());
+    return fillParallel(std::move(t), [=](float* out, size_t n, uint64_t first) {
+        rng::normal(out, n, mean, stddev, s, base, first);
+    });
+}
+
+Tensor Generator::truncatedNormal(const Shape& shape, float mean, float stddev, float bound) {
+    if (!(bound > 0.0f)) {
+        throw std::invalid_argument("truncatedNormal needs a positive bound");
+    }
+    Tensor t = Tensor::uninitialized(shape);
+    uint64_t s = seed(), base = reserve(t.size());
+    return fillParallel(std::move(t), [=](float* out, size_t n, uint64_t first) {
+        rng::truncatedNormal(out, n, mean, stddev, bound, s, base, first);
+    });
+}
+
+void manualSeed(uint64_t seed) {
+    Generator::global().manualSeed(seed);
+}
+
+// === Gewichtsinitialisierung ===
+
+std::pair<size_t, size_t> fans(const Shape& shape) {
+    if (shape.empty()) {
+        throw std::invalid_argument("Weight initialization needs at least 1D shape");
+    }
+    if (shape.size() == 1) return {shape[0], shape[0]};
+    if (shape.size() == 2) return {shape[0], shape[1]};
+    size_t receptive = 1;
+    for (size_t d = 2; d < shape.size(); ++d) receptive *= shape[d];
+    return {shape[1] * receptive, shape[0] * receptive};
+}
+
+Tensor xavierUniform(const Shape& shape, float gain, Generator& gen) {
+    auto [in, out] = fans(shape);
+    float limit = gain * std::sqrt(6.0f / static_cast<float>(in + out));
+    return gen.uniform(shape, -limit, limit);
+}
+
+Tensor xavierNormal(const Shape& shape, float gain, Generator& gen) {
+    auto [in, out] = fans(shape);
+    return gen.normal(shape, 0.0f, gain * std::sqrt(2.0f / static_cast<float>(in + out)));
+}
+
+Tensor heUniform(const Shape& shape, Generator& gen) {
+    float limit = std::sqrt(6.0f / static_cast<float>(fans(shape).first));
+    return gen.uniform(shape, -limit, limit);
+}
+
+Tensor heNormal(const Shape& shape, Generator& gen) {
+    return gen.normal(shape, 0.0f, std::sqrt(2.0f / static_cast<float>(fans(shape).first)));
+}
+
+} // namespace tensor
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+
+/**
+ * @brief Zählerbasierter Zufallsgenerator (Philox4x32-10)
+ *
+ * Statt eines Zustands, der Wert für Wert weitergeschaltet wird, ist jeder
+ * Wert eine reine Funktion von (seed, Zähler): Wert i eines Aufrufs kommt
+ * aus Block offset + i / 4, Wort i % 4. Beliebige Teilbereiche eines
+ * Tensors lassen sich so unabhängig und parallel füllen - das Ergebnis
+ * hängt weder von der Aufteilung noch von der Threadanzahl ab.
+ *
+ * Jeder Aufruf reserviert seinen Zählerbereich atomar; gleicher Seed und
+ * gleiche Aufruffolge ergeben also dieselben Tensoren.
+ */
+class Generator {
+public:
+    explicit Generator(uint64_t seed);
+
+    // Gemeinsamer Generator für Tensor::random/randn; Seed aus TENSOR_SEED
+    // oder std::random_device
+    static Generator& global();
+
+    uint64_t seed() const { return seed_.load(std::memory_order_relaxed); }
+
+    // Neuer Seed, Zähler zurück auf 0
+    void manualSeed(uint64_t seed);
+
+    // Nächster freier Block (je 4 Werte)
+    uint64_t offset() const { return offset_.load(std::memory_order_relaxed); }
+    void setOffset(uint64_t offset) { offset_.store(offset, std::memory_order_relaxed); }
+
+    // Reserviert Blöcke für n Werte und gibt den ersten zurück
+    uint64_t reserve(size_t n);
+
+    // Gleichverteilt in [min, max)
+    Tensor uniform(const Shape& shape, float min = 0.0f, float max = 1.0f);
+
+    // Normalverteilt (Box-Muller)
+    Tensor normal(const Shape& shape, float mean = 0.0f, float stddev = 1.0f);
+
+    // Normalverteilt, Werte außerhalb von mean ± bound * stddev neu gezogen
+    Tensor truncatedNormal(const Shape& shape, float mean = 0.0f, float stddev = 1.0f,
+                           float bound = 2.0f);
+
+private:
+    std::atomic<uint64_t> seed_;
+    std::atomic<uint64_t> offset_{0};
+};
+
+// Seed des globalen Generators setzen (reproduzierbare Läufe)
+void manualSeed(uint64_t seed);
+
+// === Gewichtsinitialisierung ===
+
+/**
+ * @brief Fan-in/Fan-out einer Gewichtsform
+ *
+ * 2D-Gewichte haben wie in Lektion 6 die Form (in, out); für Filter von
+ * conv2d (out, in, kh, kw) zählt die Filterfläche mit. 1D: (n, n).
+ */
+std::pair<size_t, size_t> fans(const Shape& shape);
+
+// Glorot/Xavier: Varianz 2 / (fanIn + fanOut), für tanh/sigmoid
+Tensor xavierUniform(const Shape& shape, float gain = 1.0f, Generator& gen = Generator::global());
+Tensor xavierNormal(const Shape& shape, float gain = 1.0f, Generator& gen = Generator::global());
+
+// He/Kaiming: Varianz 2 / fanIn, für ReLU
+Tensor heUniform(const Shape& shape, Generator& gen = Generator::global());
+Tensor heNormal(const Shape& shape, Generator& gen = Generator::global());
+
+namespace rng {
+
+// Die vier Wörter von Block block; attempt > 0 für Neuziehungen
+void philox(uint64_t seed, uint64_t block, uint32_t attempt, uint32_t out[4]);
+
+// === Rohkernel ===
+// out erhält die Werte first .. first + n - 1 des Stroms (seed, offset);
+// jeder Teilbereich liefert exakt dieselben Werte wie ein Gesamtaufruf.
+
+void uniform(float* out, size_t n, float min, float max,
+             uint64_t seed, uint64_t offset, uint64_t first = 0);
+void normal(float* out, size_t n, float mean, float stddev,
+            uint64_t seed, uint64_t offset, uint64_t first = 0);
+void truncatedNormal(float* out, size_t n, float mean, float stddev, float bound,
+                     uint64_t seed, uint64_t offset, uint64_t first = 0);
+
+} // namespace rng
+} // namespace tensor
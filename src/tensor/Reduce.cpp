@@ -0,0 +1,570 @@
+#include "tensor/Reduce.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/Simd.hpp"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace tensor {
+namespace reduce {
+
+namespace {
+
+// Basisfall der paarweisen Summation
+constexpr size_t PAIRWISE_BLOCK = 256;
+// Block von stats(): Mittelwert und Abweichungen im L1
+constexpr size_t STATS_BLOCK = 256;
+// Spaltenbreite eines Tasks bei inner > 1 (Akkumulatoren bleiben im L1)
+constexpr size_t COLUMN_BLOCK = 512;
+// Weniger Tasks als das: zusätzlich die Reduktionsachse aufteilen
+constexpr size_t MIN_TASKS = 16;
+constexpr size_t MAX_SEGMENTS = 64;
+
+bool useAvx2() {
+    static const bool avx2 = simd::cpu().avx2 && simd::cpu().fma;
+    return avx2;
+}
+
+float identity(Op op) {
+    switch (op) {
+        case Op::Min: return std::numeric_limits<float>::max();
+        case Op::Max: return std::numeric_limits<float>::lowest();
+        default: return 0.0f;
+    }
+}
+
+float combine(Op op, float a, float b) {
+    switch (op) {
+        case Op::Min: return std::min(a, b);
+        case Op::Max: return std::max(a, b);
+        default: return a + b;
+    }
+}
+
+float run(Op op, const float* x, size_t n) {
+    switch (op) {
+        case Op::Min: return min(x, n);
+        case Op::Max: return max(x, n);
+        default: return sum(x, n);
+    }
+}
+
+// === Lauf-Kernel ===
+
+float sumBlockScalar(const float* x, size_t n) {
+    float acc[8] = {};
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (size_t j = 0; j < 8; ++j) acc[j] += x[i + j];
+    }
+    float s = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+    for (; i < n; ++i) s += x[i];
+    return s;
+}
+
+template <bool Max>
+float extremeScalar(const float* x, size_t n) {
+    float acc[8];
+    std::fill(acc, acc + 8, Max ? std::numeric_limits<float>::lowest()
+                                : std::numeric_limits<float>::max());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (size_t j = 0; j < 8; ++j) {
+            acc[j] = Max ? std::max(acc[j], x[i + j]) : std::min(acc[j], x[i + j]);
+        }
+    }
+    for (; i < n; ++i) {
+        acc[0] = Max ? std::max(acc[0], x[i]) : std::min(acc[0], x[i]);
+    }
+    float r = acc[0];
+    for (size_t j = 1; j < 8; ++j) r = Max ? std::max(r, acc[j]) : std::min(r, acc[j]);
+    return r;
+}
+
+float prodScalar(const float* x, size_t n) {
+    float acc[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (size_t j = 0; j < 8; ++j) acc[j] *= x[i + j];
+    }
+    float p = ((acc[0] * acc[1]) * (acc[2] * acc[3])) * ((acc[4] * acc[5]) * (acc[6] * acc[7]));
+    for (; i < n; ++i) p *= x[i];
+    return p;
+}
+
+float squaresBlockScalar(const float* x, size_t n) {
+    float acc[8] = {};
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (size_t j = 0; j < 8; ++j) acc[j] += x[i + j] * x[i + j];
+    }
+    float s = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+    for (; i < n; ++i) s += x[i] * x[i];
+    return s;
+}
+
+// Summe und Mittelwert eines fertig gezählten Blocks übernehmen
+void blockMoments(Stats& s, float sum) {
+    s.sum = sum;
+    s.mean = s.count ? static_cast<double>(sum) / static_cast<double>(s.count) : 0.0;
+}
+
+Stats statsBlockScalar(const float* x, size_t n) {
+    Stats s;
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        float v = x[i];
+        if (std::isnan(v)) {
+            ++s.nanCount;
+        } else if (std::isinf(v)) {
+            ++s.infCount;
+        } else {
+            ++s.count;
+            sum += v;
+            s.min = std::min(s.min, v);
+            s.max = std::max(s.max, v);
+        }
+    }
+    blockMoments(s, sum);
+    const float mean = static_cast<float>(s.mean);
+    float m2 = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        if (std::isfinite(x[i])) m2 += (x[i] - mean) * (x[i] - mean);
+    }
+    s.m2 = m2;
+    return s;
+}
+
+#if TENSOR_X86
+
+TENSOR_TARGET("avx2,fma")
+inline float horizontalSum(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+TENSOR_TARGET("avx2,fma")
+float sumBlockAvx2(const float* x, size_t n) {
+    __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+    __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        a0 = _mm256_add_ps(a0, _mm256_loadu_ps(x + i));
+        a1 = _mm256_add_ps(a1, _mm256_loadu_ps(x + i + 8));
+        a2 = _mm256_add_ps(a2, _mm256_loadu_ps(x + i + 16));
+        a3 = _mm256_add_ps(a3, _mm256_loadu_ps(x + i + 24));
+    }
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm256_add_ps(a0, _mm256_loadu_ps(x + i));
+    }
+    float s = horizontalSum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+    for (; i < n; ++i) s += x[i];
+    return s;
+}
+
+template <bool Max>
+TENSOR_TARGET("avx2,fma")
+float extremeAvx2(const float* x, size_t n) {
+    const float init = Max ? std::numeric_limits<float>::lowest() : std::numeric_limits<float>::max();
+    __m256 a0 = _mm256_set1_ps(init), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        if (Max) {
+            a0 = _mm256_max_ps(a0, _mm256_loadu_ps(x + i));
+            a1 = _mm256_max_ps(a1, _mm256_loadu_ps(x + i + 8));
+            a2 = _mm256_max_ps(a2, _mm256_loadu_ps(x + i + 16));
+            a3 = _mm256_max_ps(a3, _mm256_loadu_ps(x + i + 24));
+        } else {
+            a0 = _mm256_min_ps(a0, _mm256_loadu_ps(x + i));
+            a1 = _mm256_min_ps(a1, _mm256_loadu_ps(x + i + 8));
+            a2 = _mm256_min_ps(a2, _mm256_loadu_ps(x + i + 16));
+            a3 = _mm256_min_ps(a3, _mm256_loadu_ps(x + i + 24));
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        a0 = Max ? _mm256_max_ps(a0, _mm256_loadu_ps(x + i))
+                 : _mm256_min_ps(a0, _mm256_loadu_ps(x + i));
+    }
+    if (Max) {
+        a0 = _mm256_max_ps(_mm256_max_ps(a0, a1), _mm256_max_ps(a2, a3));
+    } else {
+        a0 = _mm256_min_ps(_mm256_min_ps(a0, a1), _mm256_min_ps(a2, a3));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, a0);
+    float r = lanes[0];
+    for (size_t j = 1; j < 8; ++j) r = Max ? std::max(r, lanes[j]) : std::min(r, lanes[j]);
+    for (; i < n; ++i) r = Max ? std::max(r, x[i]) : std::min(r, x[i]);
+    return r;
+}
+
+TENSOR_TARGET("avx2,fma")
+float prodAvx2(const float* x, size_t n) {
+    __m256 a0 = _mm256_set1_ps(1.0f), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        a0 = _mm256_mul_ps(a0, _mm256_loadu_ps(x + i));
+        a1 = _mm256_mul_ps(a1, _mm256_loadu_ps(x + i + 8));
+        a2 = _mm256_mul_ps(a2, _mm256_loadu_ps(x + i + 16));
+        a3 = _mm256_mul_ps(a3, _mm256_loadu_ps(x + i + 24));
+    }
+    for (; i + 8 <= n; i += 8) {
+        a0 = _mm256_mul_ps(a0, _mm256_loadu_ps(x + i));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_mul_ps(_mm256_mul_ps(a0, a1), _mm256_mul_ps(a2, a3)));
+    float p = ((lanes[0] * lanes[1]) * (lanes[2] * lanes[3])) * ((lanes[4] * lanes[5]) * (lanes[6] * lanes[7]));
+    for (; i < n; ++i) p *= x[i];
+    return p;
+}
+
+TENSOR_TARGET("avx2,fma")
+float squaresBlockAvx2(const float* x, size_t n) {
+    __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+    __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256 v0 = _mm256_loadu_ps(x + i), v1 = _mm256_loadu_ps(x + i + 8);
+        __m256 v2 = _mm256_loadu_ps(x + i + 16), v3 = _mm256_loadu_ps(x + i + 24);
+        a0 = _mm256_fmadd_ps(v0, v0, a0);
+        a1 = _mm256_fmadd_ps(v1, v1, a1);
+        a2 = _mm256_fmadd_ps(v2, v2, a2);
+        a3 = _mm256_fmadd_ps(v3, v3, a3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(x + i);
+        a0 = _mm256_fmadd_ps(v, v, a0);
+    }
+    float s = horizontalSum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+    for (; i < n; ++i) s += x[i] * x[i];
+    return s;
+}
+
+// Zwei Durchläufe über einen Block im L1: zählen/summieren, dann m2
+TENSOR_TARGET("avx2,fma")
+Stats statsBlockAvx2(const float* x, size_t n) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256 negInf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    __m256 mn = inf, mx = negInf;
+    Stats s;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 v0 = _mm256_loadu_ps(x + i), v1 = _mm256_loadu_ps(x + i + 8);
+        // |v| < Inf ist für NaN und ±Inf falsch
+        __m256 f0 = _mm256_cmp_ps(_mm256_and_ps(v0, absMask), inf, _CMP_LT_OQ);
+        __m256 f1 = _mm256_cmp_ps(_mm256_and_ps(v1, absMask), inf, _CMP_LT_OQ);
+        int nan = _mm256_movemask_ps(_mm256_cmp_ps(v0, v0, _CMP_UNORD_Q)) |
+                  (_mm256_movemask_ps(_mm256_cmp_ps(v1, v1, _CMP_UNORD_Q)) << 8);
+        int fin = _mm256_movemask_ps(f0) | (_mm256_movemask_ps(f1) << 8);
+        s.count += std::bitset<16>(static_cast<unsigned>(fin)).count();
+        s.nanCount += std::bitset<16>(static_cast<unsigned>(nan)).count();
+        s0 = _mm256_add_ps(s0, _mm256_and_ps(v0, f0));
+        s1 = _mm256_add_ps(s1, _mm256_and_ps(v1, f1));
+        mn = _mm256_min_ps(mn, _mm256_min_ps(_mm256_blendv_ps(inf, v0, f0), _mm256_blendv_ps(inf, v1, f1)));
+        mx = _mm256_max_ps(mx, _mm256_max_ps(_mm256_blendv_ps(negInf, v0, f0), _mm256_blendv_ps(negInf, v1, f1)));
+    }
+    float sum = horizontalSum(_mm256_add_ps(s0, s1));
+    alignas(32) float lo[8], hi[8];
+    _mm256_store_ps(lo, mn);
+    _mm256_store_ps(hi, mx);
+    for (size_t j = 0; j < 8; ++j) {
+        s.min = std::min(s.min, lo[j]);
+        s.max = std::max(s.max, hi[j]);
+    }
+    for (size_t j = i; j < n; ++j) {
+        float v = x[j];
+        if (std::isnan(v)) {
+            ++s.nanCount;
+        } else if (std::isfinite(v)) {
+            ++s.count;
+            sum += v;
+            s.min = std::min(s.min, v);
+            s.max = std::max(s.max, v);
+        }
+    }
+    s.infCount = n - s.count - s.nanCount;
+    blockMoments(s, sum);
+
+    const __m256 mean = _mm256_set1_ps(static_cast<float>(s.mean));
+    __m256 q0 = _mm256_setzero_ps(), q1 = _mm256_setzero_ps();
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256 v0 = _mm256_loadu_ps(x + i), v1 = _mm256_loadu_ps(x + i + 8);
+        __m256 f0 = _mm256_cmp_ps(_mm256_and_ps(v0, absMask), inf, _CMP_LT_OQ);
+        __m256 f1 = _mm256_cmp_ps(_mm256_and_ps(v1, absMask), inf, _CMP_LT_OQ);
+        __m256 d0 = _mm256_and_ps(_mm256_sub_ps(v0, mean), f0);
+        __m256 d1 = _mm256_and_ps(_mm256_sub_ps(v1, mean), f1);
+        q0 = _mm256_fmadd_ps(d0, d0, q0);
+        q1 = _mm256_fmadd_ps(d1, d1, q1);
+    }
+    float m2 = horizontalSum(_mm256_add_ps(q0, q1));
+    const float m = static_cast<float>(s.mean);
+    for (; i < n; ++i) {
+        if (std::isfinite(x[i])) m2 += (x[i] - m) * (x[i] - m);
+    }
+    s.m2 = m2;
+    return s;
+}
+
+#endif // TENSOR_X86
+
+float sumBlock(const float* x, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return sumBlockAvx2(x, n);
+#endif
+    return sumBlockScalar(x, n);
+}
+
+float squaresBlock(const float* x, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return squaresBlockAvx2(x, n);
+#endif
+    return squaresBlockScalar(x, n);
+}
+
+Stats statsBlock(const float* x, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return statsBlockAvx2(x, n);
+#endif
+    return statsBlockScalar(x, n);
+}
+
+template <bool Max>
+size_t argExtreme(const float* x, size_t n) {
+    size_t best = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (Max ? x[i] > x[best] : x[i] < x[best]) best = i;
+    }
+    return best;
+}
+
+// === Spalten-Kernel (inner > 1) ===
+
+// acc[j] über Zeilen [k0, k1) einer (n, inner)-Scheibe, Spalten [j0, j0 + w)
+void columnSum(const float* in, size_t inner, size_t k0, size_t k1,
+               size_t j0, size_t w, float* acc) {
+    float comp[COLUMN_BLOCK] = {};
+    std::fill(acc, acc + w, 0.0f);
+    for (size_t k = k0; k < k1; ++k) {
+        const float* row = in + k * inner + j0;
+        for (size_t j = 0; j < w; ++j) {
+            // Kahan: verlorene Nachkommastellen in comp mitführen
+            float y = row[j] - comp[j];
+            float t = acc[j] + y;
+            comp[j] = (t - acc[j]) - y;
+            acc[j] = t;
+        }
+    }
+    for (size_t j = 0; j < w; ++j) acc[j] -= comp[j];
+}
+
+template <bool Max>
+void columnExtreme(const float* in, size_t inner, size_t k0, size_t k1,
+                   size_t j0, size_t w, float* acc) {
+    std::copy(in + k0 * inner + j0, in + k0 * inner + j0 + w, acc);
+    for (size_t k = k0 + 1; k < k1; ++k) {
+        const float* row = in + k * inner + j0;
+        for (size_t j = 0; j < w; ++j) {
+            acc[j] = Max ? (row[j] > acc[j] ? row[j] : acc[j])
+                         : (row[j] < acc[j] ? row[j] : acc[j]);
+        }
+    }
+}
+
+void column(Op op, const float* in, size_t inner, size_t k0, size_t k1,
+            size_t j0, size_t w, float* acc) {
+    switch (op) {
+        case Op::Min: return columnExtreme<false>(in, inner, k0, k1, j0, w, acc);
+        case Op::Max: return columnExtreme<true>(in, inner, k0, k1, j0, w, acc);
+        default: return columnSum(in, inner, k0, k1, j0, w, acc);
+    }
+}
+
+template <bool Max>
+void columnArg(const float* in, size_t inner, size_t n, size_t j0, size_t w, size_t* idx) {
+    float best[COLUMN_BLOCK];
+    std::copy(in + j0, in + j0 + w, best);
+    std::fill(idx, idx + w, 0);
+    for (size_t k = 1; k < n; ++k) {
+        const float* row = in + k * inner + j0;
+        for (size_t j = 0; j < w; ++j) {
+            bool better = Max ? row[j] > best[j] : row[j] < best[j];
+            best[j] = better ? row[j] : best[j];
+            idx[j] = better ? k : idx[j];
+        }
+    }
+}
+
+size_t segmentCount(size_t tasks, size_t n, size_t inner) {
+    if (tasks >= MIN_TASKS) return 1;
+    size_t threshold = Scheduler::instance().serialThreshold();
+    size_t segments = (n * inner) / threshold;
+    return std::max<size_t>(1, std::min({segments, n, MAX_SEGMENTS}));
+}
+
+} // namespace
+
+// === Öffentliche Kernel ===
+
+float sum(const float* x, size_t n) {
+    if (n <= PAIRWISE_BLOCK) return sumBlock(x, n);
+    // Teilung auf Vielfache von 8, damit die Blöcke voll vektorisiert bleiben
+    size_t half = (n / 2 + 7) & ~size_t(7);
+    return sum(x, half) + sum(x + half, n - half);
+}
+
+float min(const float* x, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return extremeAvx2<false>(x, n);
+#endif
+    return extremeScalar<false>(x, n);
+}
+
+float max(const float* x, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return extremeAvx2<true>(x, n);
+#endif
+    return extremeScalar<true>(x, n);
+}
+
+float prod(const float* x, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return prodAvx2(x, n);
+#endif
+    return prodScalar(x, n);
+}
+
+float sumSquares(const float* x, size_t n) {
+    if (n <= PAIRWISE_BLOCK) return squaresBlock(x, n);
+    size_t half = (n / 2 + 7) & ~size_t(7);
+    return sumSquares(x, half) + sumSquares(x + half, n - half);
+}
+
+Stats stats(const float* x, size_t n) {
+    Stats s;
+    for (size_t i = 0; i < n; i += STATS_BLOCK) {
+        s = merge(s, statsBlock(x + i, std::min(STATS_BLOCK, n - i)));
+    }
+    return s;
+}
+
+Stats merge(const Stats& a, const Stats& b) {
+    Stats r;
+    r.count = a.count + b.count;
+    r.nanCount = a.nanCount + b.nanCount;
+    r.infCount = a.infCount + b.infCount;
+    r.min = std::min(a.min, b.min);
+    r.max = std::max(a.max, b.max);
+    r.sum = a.sum + b.sum;
+    if (a.count == 0 || b.count == 0) {
+        r.mean = a.count ? a.mean : b.mean;
+        r.m2 = a.m2 + b.m2;
+        return r;
+    }
+    // Chan et al.: Mittelwerte und m2 zweier Teilmengen vereinigen
+    double na = static_cast<double>(a.count);
+    double nb = static_cast<double>(b.count);
+    double delta = b.mean - a.mean;
+    r.mean = a.mean + delta * nb / (na + nb);
+    r.m2 = a.m2 + b.m2 + delta * delta * na * nb / (na + nb);
+    return r;
+}
+
+size_t argmin(const float* x, size_t n) {
+    return argExtreme<false>(x, n);
+}
+
+size_t argmax(const float* x, size_t n) {
+    return argExtreme<true>(x, n);
+}
+
+void axis(Op op, const float* in, float* out, size_t outer, size_t n, size_t inner) {
+    if (outer == 0 || inner == 0) return;
+    if (n == 0) {
+        std::fill(out, out + outer * inner, identity(op));
+        return;
+    }
+
+    size_t threshold = Scheduler::instance().serialThreshold();
+    size_t colBlocks = (inner + COLUMN_BLOCK - 1) / COLUMN_BLOCK;
+    size_t tasks = inner == 1 ? outer : outer * colBlocks;
+    size_t segments = segmentCount(tasks, n, inner);
+    size_t segLen = (n + segments - 1) / segments;
+    segments = (n + segLen - 1) / segLen;
+
+    // Bei Aufteilung der Achse landen Teilergebnisse erst in partial
+    std::vector<float> partial(segments > 1 ? segments * outer * inner : 0);
+    float* dst = segments > 1 ? partial.data() : out;
+    size_t outSize = outer * inner;
+
+    // Task t: Segment t % segments von Ausgabeblock t / segments
+    size_t grain = std::max<size_t>(1, threshold / std::max<size_t>(1, segLen * std::min(inner, COLUMN_BLOCK)));
+    parallel_for(0, tasks * segments, grain, [&](size_t begin, size_t end) {
+        alignas(64) float acc[COLUMN_BLOCK];
+        for (size_t t = begin; t < end; ++t) {
+            size_t task = t / segments;
+            size_t s = t % segments;
+            size_t k0 = s * segLen;
+            size_t k1 = std::min(n, k0 + segLen);
+            float* target = dst + s * outSize;
+
+            if (inner == 1) {
+                target[task] = run(op, in + task * n + k0, k1 - k0);
+                continue;
+            }
+            size_t o = task / colBlocks;
+            size_t j0 = (task % colBlocks) * COLUMN_BLOCK;
+            size_t w = std::min(COLUMN_BLOCK, inner - j0);
+            column(op, in + o * n * inner, inner, k0, k1, j0, w, acc);
+            std::copy(acc, acc + w, target + o * inner + j0);
+        }
+    });
+
+    if (segments > 1) {
+        // Feste Reihenfolge der Segmente: Ergebnis reproduzierbar
+        parallel_for(0, outSize, 0, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                float r = partial[i];
+                for (size_t s = 1; s < segments; ++s) r = combine(op, r, partial[s * outSize + i]);
+                out[i] = r;
+            }
+        });
+    }
+}
+
+void argAxis(bool max, const float* in, size_t* out, size_t outer, size_t n, size_t inner) {
+    if (outer == 0 || inner == 0 || n == 0) return;
+
+    size_t threshold = Scheduler::instance().serialThreshold();
+    size_t colBlocks = (inner + COLUMN_BLOCK - 1) / COLUMN_BLOCK;
+    size_t tasks = inner == 1 ? outer : outer * colBlocks;
+    size_t grain = std::max<size_t>(1, threshold / (n * std::min(inner, COLUMN_BLOCK)));
+
+    parallel_for(0, tasks, grain, [&](size_t begin, size_t end) {
+        for (size_t task = begin; task < end; ++task) {
+            if (inner == 1) {
+                const float* row = in + task * n;
+                out[task] = max ? argExtreme<true>(row, n) : argExtreme<false>(row, n);
+                continue;
+            }
+            size_t o = task / colBlocks;
+            size_t j0 = (task % colBlocks) * COLUMN_BLOCK;
+            size_t w = std::min(COLUMN_BLOCK, inner - j0);
+            const float* slab = in + o * n * inner;
+            size_t* idx = out + o * inner + j0;
+            if (max) {
+                columnArg<true>(slab, inner, n, j0, w, idx);
+            } else {
+                columnArg<false>(slab, inner, n, j0, w, idx);
+            }
+        }
+    });
+}
+
+} // namespace reduce
+} // namespace tensor
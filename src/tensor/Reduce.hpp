@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace tensor {
+namespace reduce {
+
+enum class Op {
+    Sum,
+    Min,
+    Max
+};
+
+// === Zusammenhängende Läufe ===
+
+// Paarweise Summation: Fehler wächst mit log(n) statt n
+float sum(const float* x, size_t n);
+float min(const float* x, size_t n);
+float max(const float* x, size_t n);
+
+// Erster Index des kleinsten/größten Werts
+size_t argmin(const float* x, size_t n);
+size_t argmax(const float* x, size_t n);
+
+// Produkt und Quadratsumme (für norm()), mit mehreren Akkumulatoren
+float prod(const float* x, size_t n);
+float sumSquares(const float* x, size_t n);
+
+/**
+ * @brief Kennzahlen eines Laufs aus einem einzigen Speicherdurchlauf
+ *
+ * min, max, Summe und Varianz beziehen sich auf die endlichen Werte;
+ * NaN und ±Inf werden nur gezählt. Intern wird blockweise gerechnet
+ * (Mittelwert und Abweichungsquadrate eines Blocks im L1) und mit
+ * merge() nach Chan et al. zusammengeführt - so stabil wie zwei
+ * Durchläufe, ohne E[x^2] - E[x]^2.
+ */
+struct Stats {
+    size_t count = 0;     // endliche Werte
+    size_t nanCount = 0;
+    size_t infCount = 0;
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+    double sum = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;      // Summe der quadrierten Abweichungen vom Mittel
+};
+
+Stats stats(const float* x, size_t n);
+Stats merge(const Stats& a, const Stats& b);
+
+// === Achsen-Kernel ===
+
+/**
+ * @brief Reduktion über die mittlere Achse eines (outer, n, inner)-Blocks
+ *
+ * in ist zusammenhängend, out erhält (outer, inner) Werte. Für inner == 1
+ * wird jede Zeile als Lauf reduziert, sonst werden ganze Zeilen spaltenweise
+ * akkumuliert (Summen mit Kahan-Kompensation). Große Reduktionen laufen
+ * parallel; bei wenigen Ausgaben wird zusätzlich die Achse selbst aufgeteilt.
+ * Die Aufteilung hängt nicht von der Threadanzahl ab.
+ */
+void axis(Op op, const float* in, float* out, size_t outer, size_t n, size_t inner);
+
+// Index (0..n-1) des Minimums/Maximums entlang der mittleren Achse
+void argAxis(bool max, const float* in, size_t* out, size_t outer, size_t n, size_t inner);
+
+} // namespace reduce
+} // namespace tensor
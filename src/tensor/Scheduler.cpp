@@ -0,0 +1,198 @@
+#include "tensor/Scheduler.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+
+namespace tensor {
+
+namespace {
+
+// Slot des aktuellen Threads: -1 außerhalb des Pools
+thread_local long currentSlot = -1;
+thread_local int parallelDepth = 0;
+
+size_t defaultThreadCount() {
+    if (const char* env = std::getenv("TENSOR_NUM_THREADS")) {
+        long n = std::strtol(env, nullptr, 10);
+        if (n > 0) return static_cast<size_t>(n);
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+} // namespace
+
+struct Scheduler::Job {
+    RangeFn fn;
+    void* ctx;
+    size_t grain;
+    std::atomic<size_t> remaining;
+
+    std::mutex mutex;
+    std::condition_variable done;
+    bool finished = false;
+    std::exception_ptr error;
+};
+
+Scheduler& Scheduler::instance() {
+    static Scheduler scheduler;
+    return scheduler;
+}
+
+Scheduler::Scheduler() {
+    startWorkers(defaultThreadCount() - 1);
+}
+
+Scheduler::~Scheduler() {
+    stopWorkers();
+}
+
+void Scheduler::setThreadCount(size_t count) {
+    if (count == 0) count = defaultThreadCount();
+    if (count == threadCount()) return;
+    stopWorkers();
+    startWorkers(count - 1);
+}
+
+bool Scheduler::inParallelRegion() {
+    return parallelDepth > 0;
+}
+
+void Scheduler::startWorkers(size_t count) {
+    stop_ = false;
+    queues_.clear();
+    for (size_t i = 0; i <= count; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&Scheduler::workerLoop, this, i);
+    }
+}
+
+void Scheduler::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    sleepCv_.notify_all();
+    for (auto& w : workers_) {
+        w.join();
+    }
+    workers_.clear();
+}
+
+void Scheduler::workerLoop(size_t slot) {
+    currentSlot = static_cast<long>(slot);
+    while (true) {
+        Task task;
+        if (pop(slot, task) || steal(slot, task)) {
+            execute(slot, task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCv_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        if (stop_) return;
+    }
+}
+
+void Scheduler::push(size_t slot, const Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(queues_[slot]->mutex);
+        queues_[slot]->tasks.push_back(task);
+    }
+    queued_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCv_.notify_one();
+}
+
+bool Scheduler::pop(size_t slot, Task& task) {
+    Queue& q = *queues_[slot];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    queued_.fetch_sub(1);
+    return true;
+}
+
+bool Scheduler::steal(size_t thief, Task& task) {
+    size_t n = queues_.size();
+    for (size_t i = 1; i <= n; ++i) {
+        Queue& q = *queues_[(thief + i) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        task = q.tasks.front();
+        q.tasks.pop_front();
+        queued_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void Scheduler::execute(size_t slot, Task task) {
+    Job* job = task.job;
+
+    // Rekursiv halbieren: obere Hälfte zum Stehlen freigeben
+    while (task.end - task.begin > job->grain) {
+        size_t mid = task.begin + (task.end - task.begin) / 2;
+        push(slot, {job, mid, task.end});
+        task.end = mid;
+    }
+
+    ++parallelDepth;
+    try {
+        job->fn(job->ctx, task.begin, task.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        if (!job->error) job->error = std::current_exception();
+    }
+    --parallelDepth;
+
+    size_t n = task.end - task.begin;
+    if (job->remaining.fetch_sub(n) == n) {
+        // Unter dem Lock setzen: danach fasst dieser Thread den Job nicht mehr an
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished = true;
+        job->done.notify_all();
+    }
+}
+
+void Scheduler::run(size_t begin, size_t end, size_t grain, RangeFn fn, void* ctx) {
+    if (end <= begin) return;
+
+    Job job;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.grain = grain ? grain : 1;
+    job.remaining.store(end - begin);
+
+    // Externe Aufrufer teilen sich den letzten Slot
+    size_t slot = currentSlot >= 0 ? static_cast<size_t>(currentSlot) : workers_.size();
+    execute(slot, {&job, begin, end});
+
+    // Mithelfen, bis alle Teilbereiche erledigt sind
+    while (job.remaining.load() > 0) {
+        Task task;
+        if (pop(slot, task) || steal(slot, task)) {
+            execute(slot, task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait_for(lock, std::chrono::microseconds(100),
+                          [&job] { return job.finished; });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait(lock, [&job] { return job.finished; });
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+} // namespace tensor
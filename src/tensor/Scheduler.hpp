@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tensor {
+
+/**
+ * @brief Work-Stealing Thread-Pool für Tensor-Kernel
+ *
+ * Jeder Worker besitzt eine eigene Deque. Ein Bereich [begin, end) wird
+ * rekursiv halbiert: die eine Hälfte landet hinten in der eigenen Deque,
+ * die andere wird sofort bearbeitet. Untätige Worker stehlen von vorne,
+ * also die größten offenen Teilbereiche.
+ *
+ * Der aufrufende Thread arbeitet mit. Verschachtelte Aufrufe aus einem
+ * Worker heraus laufen seriell, damit kein Worker auf sich selbst wartet.
+ */
+class Scheduler {
+public:
+    // Rohe Callback-Signatur, damit der Kern ohne std::function auskommt
+    using RangeFn = void (*)(void* ctx, size_t begin, size_t end);
+
+    static Scheduler& instance();
+
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    // Gesamtzahl der Threads inkl. Aufrufer; 0 = Hardware-Threads.
+    // Darf nicht während laufender Jobs aufgerufen werden.
+    void setThreadCount(size_t count);
+    size_t threadCount() const { return workers_.size() + 1; }
+
+    // Bereiche bis zu dieser Größe (in Elementen) laufen seriell
+    void setSerialThreshold(size_t elements) { serialThreshold_ = elements ? elements : 1; }
+    size_t serialThreshold() const { return serialThreshold_; }
+
+    // Läuft der aktuelle Thread gerade innerhalb eines Jobs?
+    static bool inParallelRegion();
+
+    // Führt fn(ctx, b, e) für Teilbereiche von höchstens grain Elementen aus
+    void run(size_t begin, size_t end, size_t grain, RangeFn fn, void* ctx);
+
+private:
+    Scheduler();
+
+    struct Job;
+    struct Task {
+        Job* job;
+        size_t begin;
+        size_t end;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void startWorkers(size_t count);
+    void stopWorkers();
+    void workerLoop(size_t slot);
+
+    void push(size_t slot, const Task& task);
+    bool pop(size_t slot, Task& task);
+    bool steal(size_t thief, Task& task);
+    void execute(size_t slot, Task task);
+
+    std::vector<std::thread> workers_;
+    // Slot workers_.size() ist die gemeinsame Deque externer Aufrufer
+    std::vector<std::unique_ptr<Queue>> queues_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::atomic<size_t> queued_{0};
+    bool stop_ = false;
+
+    size_t serialThreshold_ = 32768;
+};
+
+namespace detail {
+
+template <typename F>
+void invokeRange(void* ctx, size_t begin, size_t end) {
+    (*static_cast<F*>(ctx))(begin, end);
+}
+
+} // namespace detail
+
+/**
+ * @brief Paralleles for über [begin, end)
+ *
+ * body(b, e) bearbeitet einen Teilbereich. grain ist die minimale
+ * Teilgröße; 0 verwendet die Serial-Schwelle des Schedulers.
+ */
+template <typename F>
+void parallel_for(size_t begin, size_t end, size_t grain, F&& body) {
+    if (end <= begin) return;
+    Scheduler& s = Scheduler::instance();
+    if (grain == 0) grain = s.serialThreshold();
+    if (end - begin <= grain || s.threadCount() == 1 || Scheduler::inParallelRegion()) {
+        body(begin, end);
+        return;
+    }
+    using Fn = std::remove_reference_t<F>;
+    s.run(begin, end, grain, &detail::invokeRange<Fn>,
+          const_cast<void*>(static_cast<const void*>(&body)));
+}
+
+// grain für parallel_for über Zeilen mit je workPerRow Elementen Arbeit:
+// so viele Zeilen, dass ein Teilbereich etwa die Serial-Schwelle erreicht
+inline size_t rowsPerTask(size_t workPerRow) {
+    return std::max<size_t>(1, Scheduler::instance().serialThreshold() / std::max<size_t>(1, workPerRow));
+}
+
+/**
+ * @brief Parallele Reduktion über [begin, end)
+ *
+ * map(b, e) liefert das Teilergebnis eines Bereichs, combine(x, y)
+ * verknüpft zwei Teilergebnisse. Die Aufteilung hängt nur von grain ab,
+ * nicht von der Threadanzahl - das Ergebnis ist damit reproduzierbar.
+ */
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(size_t begin, size_t end, size_t grain, T identity,
+                  Map&& map, Combine&& combine) {
+    if (end <= begin) return identity;
+    Scheduler& s = Scheduler::instance();
+    if (grain == 0) grain = s.serialThreshold();
+
+    size_t n = end - begin;
+    if (n <= grain) {
+        return combine(identity, map(begin, end));
+    }
+
+    // Anzahl der Teilbereiche begrenzen, damit der Ergebnispuffer klein bleibt
+    constexpr size_t MAX_CHUNKS = 1024;
+    size_t chunks = (n + grain - 1) / grain;
+    if (chunks > MAX_CHUNKS) {
+        grain = (n + MAX_CHUNKS - 1) / MAX_CHUNKS;
+        // Mit aufgerundetem grain reichen evtl. weniger Teilbereiche;
+        // sonst begännen die letzten hinter end
+        chunks = (n + grain - 1) / grain;
+    }
+
+    std::vector<T> partials(chunks, identity);
+    parallel_for(0, chunks, 1, [&](size_t c0, size_t c1) {
+        for (size_t c = c0; c < c1; ++c) {
+            size_t b = begin + c * grain;
+            size_t e = b + grain < end ? b + grain : end;
+            partials[c] = map(b, e);
+        }
+    });
+
+    T result = identity;
+    for (auto& p : partials) {
+        result = combine(result, p);
+    }
+    return result;
+}
+
+} // namespace tensor
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Prüfungen der ungeprüften Zugriffe (Tensor::operator() & Co.): im
+// Release-Build (NDEBUG) entfallen sie, mit -DTENSOR_BOUNDS_CHECK=1 erzwingbar
+#ifndef TENSOR_BOUNDS_CHECK
+#ifdef NDEBUG
+#define TENSOR_BOUNDS_CHECK 0
+#else
+#define TENSOR_BOUNDS_CHECK 1
+#endif
+#endif
+
+namespace tensor {
+
+/**
+ * @brief Shape bzw. Strides eines Tensors mit fester Kapazität
+ *
+ * Verhält sich wie ein std::vector<size_t>, speichert aber bis zu
+ * MAX_RANK Einträge direkt im Objekt. Konstruieren, Kopieren und
+ * Umformen von Tensoren kommen so ganz ohne Heap-Allokation aus.
+ * Mehr als MAX_RANK Achsen werfen std::invalid_argument.
+ */
+class Shape {
+public:
+    static constexpr size_t MAX_RANK = 8;
+
+    using value_type = size_t;
+    using size_type = size_t;
+    using iterator = size_t*;
+    using const_iterator = const size_t*;
+
+    Shape() = default;
+
+    // count Einträge mit value (wie std::vector(count, value))
+    explicit Shape(size_t count, size_t value = 0) {
+        resize(count, value);
+    }
+
+    Shape(std::initializer_list<size_t> values) : Shape(values.begin(), values.end()) {}
+
+    template <typename It, typename = std::enable_if_t<!std::is_integral<It>::value>>
+    Shape(It first, It last) {
+        for (; first != last; ++first) push_back(static_cast<size_t>(*first));
+    }
+
+    // Für bestehenden Code mit std::vector<size_t>
+    Shape(const std::vector<size_t>& values) : Shape(values.begin(), values.end()) {}
+
+    std::vector<size_t> toVector() const { return std::vector<size_t>(begin(), end()); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_t capacity() { return MAX_RANK; }
+
+    size_t& operator[](size_t i) { return dims_[i]; }
+    const size_t& operator[](size_t i) const { return dims_[i]; }
+
+    size_t& front() { return dims_[0]; }
+    const size_t& front() const { return dims_[0]; }
+    size_t& back() { return dims_[size_ - 1]; }
+    const size_t& back() const { return dims_[size_ - 1]; }
+
+    size_t* data() { return dims_; }
+    const size_t* data() const { return dims_; }
+
+    iterator begin() { return dims_; }
+    iterator end() { return dims_ + size_; }
+    const_iterator begin() const { return dims_; }
+    const_iterator end() const { return dims_ + size_; }
+
+    void push_back(size_t value) {
+        grow(1);
+        dims_[size_ - 1] = value;
+    }
+
+    void pop_back() { --size_; }
+    void clear() { size_ = 0; }
+
+    void resize(size_t count, size_t value = 0) {
+        size_t old = size_;
+        if (count > old) {
+            grow(count - old);
+            std::fill(dims_ + old, dims_ + count, value);
+        }
+        size_ = count;
+    }
+
+    iterator insert(const_iterator pos, size_t value) {
+        size_t i = static_cast<size_t>(pos - dims_);
+        grow(1);
+        std::move_backward(dims_ + i, dims_ + size_ - 1, dims_ + size_);
+        dims_[i] = value;
+        return dims_ + i;
+    }
+
+    iterator erase(const_iterator pos) {
+        size_t i = static_cast<size_t>(pos - dims_);
+        std::move(dims_ + i + 1, dims_ + size_, dims_ + i);
+        --size_;
+        return dims_ + i;
+    }
+
+    friend bool operator==(const Shape& a, const Shape& b) {
+        return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator!=(const Shape& a, const Shape& b) { return !(a == b); }
+
+private:
+    void grow(size_t n) {
+        if (size_ + n > MAX_RANK) {
+            throw std::invalid_argument("Tensor rank exceeds maximum of " + std::to_string(MAX_RANK));
+        }
+        size_ += n;
+    }
+
+    size_t dims_[MAX_RANK] = {};
+    size_t size_ = 0;
+};
+
+} // namespace tensor
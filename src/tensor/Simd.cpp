@@ -0,0 +1,63 @@
+#include "tensor/Simd.hpp"
+
+#if TENSOR_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace tensor {
+namespace simd {
+
+namespace {
+
+CpuFeatures detect() {
+    CpuFeatures f;
+#if TENSOR_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    f.sse2 = (info[3] & (1 << 26)) != 0;
+    f.sse41 = (info[2] & (1 << 19)) != 0;
+    f.fma = (info[2] & (1 << 12)) != 0;
+    f.f16c = (info[2] & (1 << 29)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avxBit = (info[2] & (1 << 28)) != 0;
+
+    // AVX nur nutzen, wenn das OS die YMM-Register sichert
+    bool ymmEnabled = osxsave && (_xgetbv(0) & 0x6) == 0x6;
+    f.avx = avxBit && ymmEnabled;
+    f.fma = f.fma && ymmEnabled;
+    f.f16c = f.f16c && ymmEnabled;
+
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        f.avx2 = f.avx && (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    f.sse2 = __builtin_cpu_supports("sse2");
+    f.sse41 = __builtin_cpu_supports("sse4.1");
+    f.avx = __builtin_cpu_supports("avx");
+    f.avx2 = __builtin_cpu_supports("avx2");
+    f.fma = __builtin_cpu_supports("fma");
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 11)
+    f.f16c = __builtin_cpu_supports("f16c");
+#else
+    f.f16c = false;
+#endif
+#endif
+#endif
+    return f;
+}
+
+} // namespace
+
+const CpuFeatures& cpu() {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+} // namespace simd
+} // namespace tensor
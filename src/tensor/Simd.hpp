@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @brief CPU-Feature-Erkennung und Hilfsmakros für SIMD-Kernel
+ *
+ * Die Kernel werden nicht mit globalen -mavx2 Flags übersetzt, sondern
+ * pro Funktion über TENSOR_TARGET markiert und zur Laufzeit anhand von
+ * cpu() ausgewählt. So läuft dasselbe Binary auch auf älteren CPUs.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TENSOR_X86 1
+#include <immintrin.h>
+#else
+#define TENSOR_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TENSOR_TARGET(features) __attribute__((target(features)))
+#define TENSOR_RESTRICT __restrict__
+#else
+// MSVC erlaubt Intrinsics ohne Zielattribut
+#define TENSOR_TARGET(features)
+#define TENSOR_RESTRICT __restrict
+#endif
+
+namespace tensor {
+namespace simd {
+
+struct CpuFeatures {
+    bool sse2 = false;
+    bool sse41 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+};
+
+// Einmalig erkannte Features der aktuellen CPU
+const CpuFeatures& cpu();
+
+} // namespace simd
+} // namespace tensor
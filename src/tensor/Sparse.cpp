@@ -0,0 +1,678 @@
+#include "tensor/Sparse.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/Simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace tensor {
+
+namespace {
+
+using Index = SparseTensor::Index;
+
+size_t ceilDiv(size_t a, size_t b) {
+    return (a + b - 1) / b;
+}
+
+void checkDims(size_t rows, size_t cols) {
+    constexpr size_t limit = std::numeric_limits<Index>::max();
+    if (rows > limit || cols > limit) {
+        throw std::invalid_argument("SparseTensor dimensions exceed 32-bit indices");
+    }
+}
+
+// Zeilenzeiger und Spaltenindizes einer CSR/BSR-Struktur prüfen
+void checkCompressed(const std::vector<size_t>& rowPtr, const std::vector<Index>& colIndices,
+                     size_t rows, size_t cols) {
+    if (rowPtr.size() != rows + 1 || rowPtr.front() != 0 || rowPtr.back() != colIndices.size()) {
+        throw std::invalid_argument("Invalid sparse row pointer array");
+    }
+    // Erst alle Zeiger, dann die Spalten: sonst liefe ein zu großer
+    // Zeiger mitten im Array über colIndices hinaus
+    for (size_t r = 0; r < rows; ++r) {
+        if (rowPtr[r] > rowPtr[r + 1] || rowPtr[r + 1] > colIndices.size()) {
+            throw std::invalid_argument("Sparse row pointers must be non-decreasing");
+        }
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t p = rowPtr[r]; p < rowPtr[r + 1]; ++p) {
+            if (colIndices[p] >= cols || (p > rowPtr[r] && colIndices[p] <= colIndices[p - 1])) {
+                throw std::invalid_argument("Sparse column indices must be sorted and in range");
+            }
+        }
+    }
+}
+
+// Breite der Registerkacheln im SpMM-Kernel (4 AVX-Register)
+constexpr size_t SPMM_TILE = 32;
+
+bool useAvx2() {
+    static const bool avx2 = simd::cpu().avx2 && simd::cpu().fma;
+    return avx2;
+}
+
+void axpyScalar(float* TENSOR_RESTRICT o, const float* TENSOR_RESTRICT b, float a, size_t n) {
+    for (size_t j = 0; j < n; ++j) o[j] += a * b[j];
+}
+
+// o[0..n) = Summe über p in [p0, p1) von val[p] * (Zeile col[p] von b)
+void csrRowScalar(float* TENSOR_RESTRICT o, const float* TENSOR_RESTRICT b, const Index* col,
+                  const float* val, size_t p0, size_t p1, size_t n) {
+    for (size_t p = p0; p < p1; ++p) axpyScalar(o, b + col[p] * n, val[p], n);
+}
+
+#if TENSOR_X86
+
+TENSOR_TARGET("avx2,fma")
+void axpyAvx2(float* o, const float* b, float a, size_t n) {
+    const __m256 va = _mm256_set1_ps(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        _mm256_storeu_ps(o + j, _mm256_fmadd_ps(va, _mm256_loadu_ps(b + j), _mm256_loadu_ps(o + j)));
+    }
+    for (; j < n; ++j) o[j] += a * b[j];
+}
+
+// Die Ausgabezeile wird in Kacheln zu SPMM_TILE Spalten in Registern
+// akkumuliert und nur einmal geschrieben, statt je Nicht-Null einmal
+TENSOR_TARGET("avx2,fma")
+void csrRowAvx2(float* o, const float* b, const Index* col, const float* val,
+                size_t p0, size_t p1, size_t n) {
+    size_t j = 0;
+    for (; j + SPMM_TILE <= n; j += SPMM_TILE) {
+        __m256 a0 = _mm256_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+        for (size_t p = p0; p < p1; ++p) {
+            const __m256 v = _mm256_set1_ps(val[p]);
+            const float* row = b + col[p] * n + j;
+            a0 = _mm256_fmadd_ps(v, _mm256_loadu_ps(row), a0);
+            a1 = _mm256_fmadd_ps(v, _mm256_loadu_ps(row + 8), a1);
+            a2 = _mm256_fmadd_ps(v, _mm256_loadu_ps(row + 16), a2);
+            a3 = _mm256_fmadd_ps(v, _mm256_loadu_ps(row + 24), a3);
+        }
+        _mm256_storeu_ps(o + j, a0);
+        _mm256_storeu_ps(o + j + 8, a1);
+        _mm256_storeu_ps(o + j + 16, a2);
+        _mm256_storeu_ps(o + j + 24, a3);
+    }
+    for (; j + 8 <= n; j += 8) {
+        __m256 a0 = _mm256_setzero_ps();
+        for (size_t p = p0; p < p1; ++p) {
+            a0 = _mm256_fmadd_ps(_mm256_set1_ps(val[p]), _mm256_loadu_ps(b + col[p] * n + j), a0);
+        }
+        _mm256_storeu_ps(o + j, a0);
+    }
+    for (; j < n; ++j) {
+        float acc = 0.0f;
+        for (size_t p = p0; p < p1; ++p) acc += val[p] * b[col[p] * n + j];
+        o[j] = acc;
+    }
+}
+
+#endif
+
+// o[0..n) += a * b[0..n)
+void axpy(float* o, const float* b, float a, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return axpyAvx2(o, b, a, n);
+#endif
+    axpyScalar(o, b, a, n);
+}
+
+// Ausgabezeile einer CSR-Zeile; o muss vorher mit Nullen gefüllt sein
+void csrRow(float* o, const float* b, const Index* col, const float* val,
+            size_t p0, size_t p1, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return csrRowAvx2(o, b, col, val, p0, p1, n);
+#endif
+    csrRowScalar(o, b, col, val, p0, p1, n);
+}
+
+} // namespace
+
+const char* sparseFormatName(SparseFormat format) {
+    switch (format) {
+        case SparseFormat::COO: return "coo";
+        case SparseFormat::CSR: return "csr";
+        case SparseFormat::BSR: return "bsr";
+    }
+    return "unknown";
+}
+
+// === Konstruktion ===
+
+SparseTensor::SparseTensor(size_t rows, size_t cols) : rows_(rows), cols_(cols) {
+    checkDims(rows, cols);
+}
+
+SparseTensor SparseTensor::fromDense(const Tensor& dense, SparseFormat format, float threshold,
+                                     size_t blockSize) {
+    if (dense.rank() != 2) {
+        throw std::invalid_argument("SparseTensor::fromDense requires a 2D tensor, got " +
+                                    dense.shapeString());
+    }
+    const Tensor src = dense.to(DType::Float32).contiguous();
+    const size_t rows = src.shape()[0];
+    const size_t cols = src.shape()[1];
+    const float* in = src.data();
+
+    SparseTensor result(rows, cols);
+    result.format_ = SparseFormat::CSR;
+
+    // Erst zählen, dann füllen - beide Durchläufe parallel über die Zeilen.
+    // NaN zählt als Nicht-Null (!(|x| <= threshold)).
+    std::vector<size_t>& ptr = result.rowPtr_;
+    ptr.assign(rows + 1, 0);
+    parallel_for(0, rows, rowsPerTask(cols), [&](size_t r0, size_t r1) {
+        for (size_t r = r0; r < r1; ++r) {
+            const float* row = in + r * cols;
+            size_t count = 0;
+            for (size_t c = 0; c < cols; ++c) count += !(std::fabs(row[c]) <= threshold);
+            ptr[r + 1] = count;
+        }
+    });
+    for (size_t r = 0; r < rows; ++r) ptr[r + 1] += ptr[r];
+
+    result.colIndices_.resize(ptr[rows]);
+    result.values_.resize(ptr[rows]);
+    parallel_for(0, rows, rowsPerTask(cols), [&](size_t r0, size_t r1) {
+        for (size_t r = r0; r < r1; ++r) {
+            const float* row = in + r * cols;
+            size_t p = ptr[r];
+            for (size_t c = 0; c < cols; ++c) {
+                if (!(std::fabs(row[c]) <= threshold)) {
+                    result.colIndices_[p] = static_cast<Index>(c);
+                    result.values_[p++] = row[c];
+                }
+            }
+        }
+    });
+
+    return format == SparseFormat::CSR ? result : result.to(format, blockSize);
+}
+
+SparseTensor SparseTensor::identity(size_t n) {
+    SparseTensor result(n, n);
+    result.format_ = SparseFormat::CSR;
+    result.rowPtr_.resize(n + 1);
+    result.colIndices_.resize(n);
+    result.values_.assign(n, 1.0f);
+    for (size_t i = 0; i < n; ++i) {
+        result.rowPtr_[i] = i;
+        result.colIndices_[i] = static_cast<Index>(i);
+    }
+    result.rowPtr_[n] = n;
+    return result;
+}
+
+SparseTensor SparseTensor::fromCOO(size_t rows, size_t cols, std::vector<Index> rowIndices,
+                                   std::vector<Index> colIndices, std::vector<float> values) {
+    SparseTensor result(rows, cols);
+    if (rowIndices.size() != values.size() || colIndices.size() != values.size()) {
+        throw std::invalid_argument("COO index and value arrays must have the same length");
+    }
+    for (size_t k = 0; k < values.size(); ++k) {
+        if (rowIndices[k] >= rows || colIndices[k] >= cols) {
+            throw std::invalid_argument("COO index out of range");
+        }
+    }
+    result.rowIndices_ = std::move(rowIndices);
+    result.colIndices_ = std::move(colIndices);
+    result.values_ = std::move(values);
+    return result;
+}
+
+SparseTensor SparseTensor::fromCSR(size_t rows, size_t cols, std::vector<size_t> rowPtr,
+                                   std::vector<Index> colIndices, std::vector<float> values) {
+    SparseTensor result(rows, cols);
+    if (colIndices.size() != values.size()) {
+        throw std::invalid_argument("CSR index and value arrays must have the same length");
+    }
+    checkCompressed(rowPtr, colIndices, rows, cols);
+    result.format_ = SparseFormat::CSR;
+    result.rowPtr_ = std::move(rowPtr);
+    result.colIndices_ = std::move(colIndices);
+    result.values_ = std::move(values);
+    return result;
+}
+
+SparseTensor SparseTensor::fromBSR(size_t rows, size_t cols, size_t blockSize, std::vector<size_t> rowPtr,
+                                   std::vector<Index> colIndices, std::vector<float> values) {
+    SparseTensor result(rows, cols);
+    if (blockSize == 0 || blockSize > std::max(rows, cols)) {
+        throw std::invalid_argument("BSR block size must be between 1 and the matrix size");
+    }
+    // rows/cols passen in 32 Bit, blockSize^2 also in size_t; das Produkt
+    // mit der Blockanzahl kann trotzdem überlaufen
+    const size_t blockArea = blockSize * blockSize;
+    if (colIndices.size() > std::numeric_limits<size_t>::max() / blockArea ||
+        values.size() != colIndices.size() * blockArea) {
+        throw std::invalid_argument("BSR value array must hold blockSize^2 values per block");
+    }
+    checkCompressed(rowPtr, colIndices, ceilDiv(rows, blockSize), ceilDiv(cols, blockSize));
+    result.format_ = SparseFormat::BSR;
+    result.blockSize_ = blockSize;
+    result.rowPtr_ = std::move(rowPtr);
+    result.colIndices_ = std::move(colIndices);
+    result.values_ = std::move(values);
+    return result;
+}
+
+void SparseTensor::insert(size_t row, size_t col, float value) {
+    if (format_ != SparseFormat::COO) {
+        throw std::invalid_argument("SparseTensor::insert requires COO format, got " +
+                                    std::string(sparseFormatName(format_)));
+    }
+    checkIndex(row, col);
+    rowIndices_.push_back(static_cast<Index>(row));
+    colIndices_.push_back(static_cast<Index>(col));
+    values_.push_back(value);
+}
+
+void SparseTensor::reserve(size_t entries) {
+    if (format_ == SparseFormat::COO) rowIndices_.reserve(entries);
+    colIndices_.reserve(entries);
+    values_.reserve(entries);
+}
+
+void SparseTensor::checkIndex(size_t row, size_t col) const {
+    if (row >= rows_ || col >= cols_) {
+        throw std::out_of_range("Sparse index (" + std::to_string(row) + ", " + std::to_string(col) +
+                                ") out of range");
+    }
+}
+
+// === Umwandlung ===
+
+SparseTensor SparseTensor::to(SparseFormat format, size_t blockSize) const {
+    switch (format) {
+        case SparseFormat::COO: return toCOO();
+        case SparseFormat::CSR: return toCSR();
+        case SparseFormat::BSR: return toBSR(blockSize);
+    }
+    return *this;
+}
+
+SparseTensor SparseTensor::toCOO() const {
+    if (format_ == SparseFormat::COO) return *this;
+    if (format_ == SparseFormat::BSR) return toCSR().toCOO();
+
+    SparseTensor result = *this;
+    result.format_ = SparseFormat::COO;
+    result.rowPtr_.clear();
+    result.rowIndices_.resize(values_.size());
+    for (size_t r = 0; r < rows_; ++r) {
+        std::fill(result.rowIndices_.begin() + rowPtr_[r], result.rowIndices_.begin() + rowPtr_[r + 1],
+                  static_cast<Index>(r));
+    }
+    return result;
+}
+
+SparseTensor SparseTensor::toCSR() const {
+    if (format_ == SparseFormat::CSR) return *this;
+
+    SparseTensor result(rows_, cols_);
+    result.format_ = SparseFormat::CSR;
+    std::vector<size_t>& ptr = result.rowPtr_;
+    std::vector<Index>& cols = result.colIndices_;
+    std::vector<float>& vals = result.values_;
+    ptr.assign(rows_ + 1, 0);
+
+    if (format_ == SparseFormat::BSR) {
+        // Blockzeilen Zeile für Zeile abrollen; die Blockspalten sind
+        // sortiert, also auch die Spalten. Füllnullen fallen weg.
+        const size_t b = blockSize_;
+        for (size_t br = 0; br + 1 < rowPtr_.size(); ++br) {
+            for (size_t i = 0; i < b && br * b + i < rows_; ++i) {
+                for (size_t k = rowPtr_[br]; k < rowPtr_[br + 1]; ++k) {
+                    const size_t c0 = static_cast<size_t>(colIndices_[k]) * b;
+                    const float* block = values_.data() + k * b * b + i * b;
+                    for (size_t j = 0; j < b && c0 + j < cols_; ++j) {
+                        if (block[j] != 0.0f) {
+                            cols.push_back(static_cast<Index>(c0 + j));
+                            vals.push_back(block[j]);
+                        }
+                    }
+                }
+                ptr[br * b + i + 1] = vals.size();
+            }
+        }
+        return result;
+    }
+
+    // COO: Counting-Sort nach Zeile (stabil) ...
+    for (Index r : rowIndices_) ++ptr[r + 1];
+    for (size_t r = 0; r < rows_; ++r) ptr[r + 1] += ptr[r];
+    cols.resize(values_.size());
+    vals.resize(values_.size());
+    {
+        std::vector<size_t> next(ptr.begin(), ptr.end() - 1);
+        for (size_t k = 0; k < values_.size(); ++k) {
+            size_t p = next[rowIndices_[k]]++;
+            cols[p] = colIndices_[k];
+            vals[p] = values_[k];
+        }
+    }
+
+    // ... dann je Zeile nach Spalte sortieren, Duplikate summieren und
+    // nach vorne zusammenschieben
+    std::vector<std::pair<Index, float>> entries;
+    size_t out = 0;
+    size_t begin = 0;
+    for (size_t r = 0; r < rows_; ++r) {
+        const size_t end = ptr[r + 1];
+        const size_t rowStart = out;
+        bool sorted = true;
+        for (size_t p = begin + 1; p < end && sorted; ++p) sorted = cols[p] > cols[p - 1];
+
+        if (sorted) {
+            for (size_t p = begin; p < end; ++p, ++out) {
+                cols[out] = cols[p];
+                vals[out] = vals[p];
+            }
+        } else {
+            entries.clear();
+            for (size_t p = begin; p < end; ++p) entries.emplace_back(cols[p], vals[p]);
+            std::stable_sort(entries.begin(), entries.end(),
+                             [](const auto& x, const auto& y) { return x.first < y.first; });
+            for (const auto& [c, v] : entries) {
+                if (out > rowStart && cols[out - 1] == c) {
+                    vals[out - 1] += v;
+                } else {
+                    cols[out] = c;
+                    vals[out++] = v;
+                }
+            }
+        }
+        ptr[r] = rowStart;
+        begin = end;
+    }
+    ptr[rows_] = out;
+    cols.resize(out);
+    vals.resize(out);
+    return result;
+}
+
+SparseTensor SparseTensor::toBSR(size_t blockSize) const {
+    if (blockSize == 0) {
+        throw std::invalid_argument("BSR block size must be positive");
+    }
+    if (format_ == SparseFormat::BSR && blockSize_ == blockSize) return *this;
+    if (format_ != SparseFormat::CSR) return toCSR().toBSR(blockSize);
+
+    const size_t b = blockSize;
+    const size_t blockRows = ceilDiv(rows_, b);
+    const size_t blockCols = ceilDiv(cols_, b);
+
+    SparseTensor result(rows_, cols_);
+    result.format_ = SparseFormat::BSR;
+    result.blockSize_ = b;
+    result.rowPtr_.assign(blockRows + 1, 0);
+
+    // slot[bc]: Position des Blocks bc in der aktuellen Blockzeile;
+    // owner[bc] merkt sich, für welche Blockzeile slot gilt
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+    std::vector<size_t> owner(blockCols, none);
+    std::vector<size_t> slot(blockCols);
+    std::vector<Index> found;
+
+    for (size_t br = 0; br < blockRows; ++br) {
+        const size_t r0 = br * b;
+        const size_t r1 = std::min(rows_, r0 + b);
+
+        found.clear();
+        for (size_t p = rowPtr_[r0]; p < rowPtr_[r1]; ++p) {
+            const size_t bc = colIndices_[p] / b;
+            if (owner[bc] != br) {
+                owner[bc] = br;
+                found.push_back(static_cast<Index>(bc));
+            }
+        }
+        std::sort(found.begin(), found.end());
+
+        const size_t first = result.colIndices_.size();
+        for (size_t i = 0; i < found.size(); ++i) slot[found[i]] = first + i;
+        result.colIndices_.insert(result.colIndices_.end(), found.begin(), found.end());
+        result.values_.resize(result.colIndices_.size() * b * b, 0.0f);
+
+        for (size_t r = r0; r < r1; ++r) {
+            for (size_t p = rowPtr_[r]; p < rowPtr_[r + 1]; ++p) {
+                const size_t c = colIndices_[p];
+                result.values_[slot[c / b] * b * b + (r - r0) * b + c % b] = values_[p];
+            }
+        }
+        result.rowPtr_[br + 1] = result.colIndices_.size();
+    }
+    return result;
+}
+
+Tensor SparseTensor::toDense() const {
+    Tensor result = Tensor::zeros({rows_, cols_});
+    float* out = result.data();
+
+    if (format_ == SparseFormat::COO) {
+        for (size_t k = 0; k < values_.size(); ++k) {
+            out[static_cast<size_t>(rowIndices_[k]) * cols_ + colIndices_[k]] += values_[k];
+        }
+    } else if (format_ == SparseFormat::CSR) {
+        parallel_for(0, rows_, rowsPerTask(nnz() / std::max<size_t>(1, rows_) + 1), [&](size_t r0, size_t r1) {
+            for (size_t r = r0; r < r1; ++r) {
+                float* row = out + r * cols_;
+                for (size_t p = rowPtr_[r]; p < rowPtr_[r + 1]; ++p) row[colIndices_[p]] = values_[p];
+            }
+        });
+    } else {
+        const size_t b = blockSize_;
+        parallel_for(0, rowPtr_.size() - 1, rowsPerTask(b * cols_ / 4 + 1), [&](size_t b0, size_t b1) {
+            for (size_t br = b0; br < b1; ++br) {
+                for (size_t k = rowPtr_[br]; k < rowPtr_[br + 1]; ++k) {
+                    const size_t c0 = static_cast<size_t>(colIndices_[k]) * b;
+                    const size_t width = std::min(b, cols_ - c0);
+                    for (size_t i = 0; i < b && br * b + i < rows_; ++i) {
+                        std::copy_n(values_.data() + k * b * b + i * b, width,
+                                    out + (br * b + i) * cols_ + c0);
+                    }
+                }
+            }
+        });
+    }
+    return result;
+}
+
+// === Eigenschaften ===
+
+float SparseTensor::density() const {
+    const size_t total = rows_ * cols_;
+    return total ? static_cast<float>(nnz()) / static_cast<float>(total) : 0.0f;
+}
+
+size_t SparseTensor::nbytes() const {
+    return rowPtr_.size() * sizeof(size_t) + rowIndices_.size() * sizeof(Index) +
+           colIndices_.size() * sizeof(Index) + values_.size() * sizeof(float);
+}
+
+float SparseTensor::at(size_t row, size_t col) const {
+    checkIndex(row, col);
+
+    if (format_ == SparseFormat::COO) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < values_.size(); ++k) {
+            if (rowIndices_[k] == row && colIndices_[k] == col) sum += values_[k];
+        }
+        return sum;
+    }
+
+    const size_t b = format_ == SparseFormat::BSR ? blockSize_ : 1;
+    const size_t r = row / b;
+    const Index c = static_cast<Index>(col / b);
+    auto first = colIndices_.begin() + rowPtr_[r];
+    auto last = colIndices_.begin() + rowPtr_[r + 1];
+    auto it = std::lower_bound(first, last, c);
+    if (it == last || *it != c) return 0.0f;
+
+    const size_t k = static_cast<size_t>(it - colIndices_.begin());
+    return values_[k * b * b + (row % b) * b + col % b];
+}
+
+SparseTensor SparseTensor::transpose() const {
+    if (format_ != SparseFormat::CSR) return toCSR().transpose();
+
+    // Counting-Sort nach Spalte; Zeilen werden der Reihe nach verteilt,
+    // also sind die neuen Spaltenindizes automatisch sortiert
+    SparseTensor result(cols_, rows_);
+    result.format_ = SparseFormat::CSR;
+    std::vector<size_t>& ptr = result.rowPtr_;
+    ptr.assign(cols_ + 1, 0);
+    for (Index c : colIndices_) ++ptr[c + 1];
+    for (size_t c = 0; c < cols_; ++c) ptr[c + 1] += ptr[c];
+
+    result.colIndices_.resize(nnz());
+    result.values_.resize(nnz());
+    std::vector<size_t> next(ptr.begin(), ptr.end() - 1);
+    for (size_t r = 0; r < rows_; ++r) {
+        for (size_t p = rowPtr_[r]; p < rowPtr_[r + 1]; ++p) {
+            size_t q = next[colIndices_[p]]++;
+            result.colIndices_[q] = static_cast<Index>(r);
+            result.values_[q] = values_[p];
+        }
+    }
+    return result;
+}
+
+// === Produkte ===
+
+Tensor SparseTensor::matmul(const Tensor& other) const {
+    if (format_ == SparseFormat::COO) return toCSR().matmul(other);
+
+    if (other.rank() != 1 && other.rank() != 2) {
+        throw std::invalid_argument("SparseTensor::matmul requires a 1D or 2D tensor, got " +
+                                    other.shapeString());
+    }
+    if (other.shape()[0] != cols_) {
+        throw std::invalid_argument("Incompatible shapes for matmul: (" + std::to_string(rows_) + ", " +
+                                    std::to_string(cols_) + ") and " + other.shapeString());
+    }
+
+    const Tensor x = other.to(DType::Float32).contiguous();
+    const float* in = x.data();
+    const size_t n = other.rank() == 2 ? other.shape()[1] : 1;
+    Tensor result = other.rank() == 2 ? Tensor::zeros({rows_, n}) : Tensor::zeros({rows_});
+    float* out = result.data();
+
+    const size_t* ptr = rowPtr_.data();
+    const Index* col = colIndices_.data();
+    const float* val = values_.data();
+
+    if (format_ == SparseFormat::CSR) {
+        const size_t perRow = nnz() / std::max<size_t>(1, rows_) + 1;
+        if (n == 1) {
+            // SpMV: zwei Akkumulatoren, damit die Gather-Latenz überlappt
+            parallel_for(0, rows_, rowsPerTask(perRow), [&](size_t r0, size_t r1) {
+                for (size_t r = r0; r < r1; ++r) {
+                    float acc0 = 0.0f, acc1 = 0.0f;
+                    size_t p = ptr[r];
+                    for (; p + 1 < ptr[r + 1]; p += 2) {
+                        acc0 += val[p] * in[col[p]];
+                        acc1 += val[p + 1] * in[col[p + 1]];
+                    }
+                    if (p < ptr[r + 1]) acc0 += val[p] * in[col[p]];
+                    out[r] = acc0 + acc1;
+                }
+            });
+        } else {
+            // SpMM: Ausgabezeile r = Summe val * (Zeile col von other)
+            parallel_for(0, rows_, rowsPerTask(perRow * n), [&](size_t r0, size_t r1) {
+                for (size_t r = r0; r < r1; ++r) csrRow(out + r * n, in, col, val, ptr[r], ptr[r + 1], n);
+            });
+        }
+        return result;
+    }
+
+    // BSR: je Blockzeile ein dichter b x b-Block nach dem anderen
+    const size_t b = blockSize_;
+    const size_t blockRows = rowPtr_.size() - 1;
+    const size_t perBlockRow = (nnz() / std::max<size_t>(1, blockRows) + 1) * n;
+    parallel_for(0, blockRows, rowsPerTask(perBlockRow), [&](size_t b0, size_t b1) {
+        for (size_t br = b0; br < b1; ++br) {
+            const size_t height = std::min(b, rows_ - br * b);
+            for (size_t k = ptr[br]; k < ptr[br + 1]; ++k) {
+                const size_t c0 = static_cast<size_t>(col[k]) * b;
+                const size_t width = std::min(b, cols_ - c0);
+                const float* block = val + k * b * b;
+                for (size_t i = 0; i < height; ++i) {
+                    float* o = out + (br * b + i) * n;
+                    if (n == 1) {
+                        float acc = 0.0f;
+                        for (size_t j = 0; j < width; ++j) acc += block[i * b + j] * in[c0 + j];
+                        *o += acc;
+                    } else {
+                        for (size_t j = 0; j < width; ++j) {
+                            const float a = block[i * b + j];
+                            if (a != 0.0f) axpy(o, in + (c0 + j) * n, a, n);
+                        }
+                    }
+                }
+            }
+        }
+    });
+    return result;
+}
+
+std::string SparseTensor::toString() const {
+    std::ostringstream oss;
+    oss << "SparseTensor(" << sparseFormatName(format_) << ", shape=(" << rows_ << ", " << cols_
+        << "), nnz=" << nnz();
+    if (format_ == SparseFormat::BSR) oss << ", block=" << blockSize_;
+    oss << ", density=" << density() * 100.0f << "%)";
+    return oss.str();
+}
+
+Tensor matmul(const SparseTensor& a, const Tensor& b) {
+    return a.matmul(b);
+}
+
+Tensor matmul(const Tensor& a, const SparseTensor& b) {
+    if (a.rank() != 1 && a.rank() != 2) {
+        throw std::invalid_argument("matmul with SparseTensor requires a 1D or 2D tensor, got " +
+                                    a.shapeString());
+    }
+    const size_t k = a.shape()[a.rank() - 1];
+    if (k != b.rows()) {
+        throw std::invalid_argument("Incompatible shapes for matmul: " + a.shapeString() + " and (" +
+                                    std::to_string(b.rows()) + ", " + std::to_string(b.cols()) + ")");
+    }
+
+    // Zeile i der Ausgabe = Summe a[i, kk] * (Zeile kk von b); in CSR
+    // sind das Scatter-Adds in eine Ausgabezeile, die im Cache bleibt
+    SparseTensor converted;
+    const SparseTensor& w = b.format() == SparseFormat::CSR ? b : (converted = b.toCSR());
+
+    const Tensor x = a.to(DType::Float32).contiguous();
+    const float* in = x.data();
+    const size_t m = a.rank() == 2 ? a.shape()[0] : 1;
+    const size_t n = w.cols();
+    Tensor result = a.rank() == 2 ? Tensor::zeros({m, n}) : Tensor::zeros({n});
+    float* out = result.data();
+
+    const size_t* ptr = w.rowPtr().data();
+    const Index* col = w.colIndices().data();
+    const float* val = w.values().data();
+
+    parallel_for(0, m, rowsPerTask(w.nnz() + k), [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            const float* row = in + i * k;
+            float* o = out + i * n;
+            for (size_t kk = 0; kk < k; ++kk) {
+                const float s = row[kk];
+                if (s == 0.0f) continue;
+                for (size_t p = ptr[kk]; p < ptr[kk + 1]; ++p) o[col[p]] += s * val[p];
+            }
+        }
+    });
+    return result;
+}
+
+} // namespace tensor
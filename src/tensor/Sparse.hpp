@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+
+/**
+ * @brief Speicherformate für dünn besetzte Matrizen
+ *
+ * COO: (Zeile, Spalte, Wert)-Tripel in beliebiger Reihenfolge, zum Aufbauen
+ * CSR: Zeilenzeiger + Spaltenindizes, je Zeile sortiert; für SpMV/SpMM
+ * BSR: wie CSR, aber über dichte blockSize x blockSize-Blöcke; lohnt sich,
+ *      wenn die Nicht-Nullen in Blöcken liegen (z.B. blockweises Pruning)
+ */
+enum class SparseFormat : uint8_t {
+    COO,
+    CSR,
+    BSR
+};
+
+/**
+ * @brief Dünn besetzte 2D-Matrix (float32)
+ *
+ * Gespeichert werden nur die Nicht-Null-Einträge; eine n x n-Einheitsmatrix
+ * braucht so n statt n² Werte. Aufgebaut wird in COO (insert(), fromCOO),
+ * gerechnet in CSR bzw. BSR - matmul() wandelt COO dafür selbst um.
+ * Doppelte COO-Einträge werden bei der Umwandlung summiert.
+ *
+ * Die Indexarrays sind öffentlich lesbar, damit sich andere Kernel (und
+ * TensorDB beim Speichern) direkt darauf stützen können.
+ */
+class SparseTensor {
+public:
+    using Index = uint32_t;
+
+    SparseTensor() = default;
+
+    // Leere Matrix im COO-Format
+    SparseTensor(size_t rows, size_t cols);
+
+    // === Factory-Methoden ===
+
+    // Übernimmt alle Werte mit |x| > threshold aus einem 2D-Tensor
+    static SparseTensor fromDense(const Tensor& dense, SparseFormat format = SparseFormat::CSR,
+                                  float threshold = 0.0f, size_t blockSize = 4);
+    static SparseTensor identity(size_t n);
+
+    // Aus rohen Arrays; die Struktur wird geprüft (std::invalid_argument)
+    static SparseTensor fromCOO(size_t rows, size_t cols, std::vector<Index> rowIndices,
+                                std::vector<Index> colIndices, std::vector<float> values);
+    static SparseTensor fromCSR(size_t rows, size_t cols, std::vector<size_t> rowPtr,
+                                std::vector<Index> colIndices, std::vector<float> values);
+    // rowPtr/colIndices zählen Blöcke, values enthält je Block
+    // blockSize² Werte zeilenweise; Randblöcke sind mit Nullen aufgefüllt
+    static SparseTensor fromBSR(size_t rows, size_t cols, size_t blockSize, std::vector<size_t> rowPtr,
+                                std::vector<Index> colIndices, std::vector<float> values);
+
+    // === Aufbauen (nur COO) ===
+
+    void insert(size_t row, size_t col, float value);
+    void reserve(size_t entries);
+
+    // === Umwandlung ===
+
+    SparseTensor toCOO() const;
+    SparseTensor toCSR() const;
+    SparseTensor toBSR(size_t blockSize = 4) const;
+    SparseTensor to(SparseFormat format, size_t blockSize = 4) const;
+    Tensor toDense() const;
+
+    // === Eigenschaften ===
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    Shape shape() const { return {rows_, cols_}; }
+    SparseFormat format() const { return format_; }
+    size_t blockSize() const { return blockSize_; }
+
+    // Gespeicherte Werte (bei BSR inklusive der Nullen in Blöcken)
+    size_t nnz() const { return values_.size(); }
+    float density() const;
+    size_t nbytes() const;
+
+    const std::vector<size_t>& rowPtr() const { return rowPtr_; }
+    const std::vector<Index>& rowIndices() const { return rowIndices_; }
+    const std::vector<Index>& colIndices() const { return colIndices_; }
+    const std::vector<float>& values() const { return values_; }
+
+    // Einzelwert (CSR/BSR per binärer Suche, COO linear)
+    float at(size_t row, size_t col) const;
+
+    // Ergebnis in CSR
+    SparseTensor transpose() const;
+
+    // === Produkte mit dichten Tensoren (mehrere Threads) ===
+
+    // other 1D (cols): SpMV, Ergebnis (rows); other 2D (cols, n): SpMM,
+    // Ergebnis (rows, n). Immer float32.
+    Tensor matmul(const Tensor& other) const;
+
+    std::string toString() const;
+
+private:
+    void checkIndex(size_t row, size_t col) const;
+
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    SparseFormat format_ = SparseFormat::COO;
+    size_t blockSize_ = 1;
+
+    std::vector<size_t> rowPtr_;      // CSR/BSR: rows_ (bzw. Blockzeilen) + 1 Einträge
+    std::vector<Index> rowIndices_;   // nur COO
+    std::vector<Index> colIndices_;
+    std::vector<float> values_;
+};
+
+// Sparse @ dicht bzw. dicht @ sparse; dense 1D wird wie bei
+// Tensor::matmul als Zeile bzw. Spalte behandelt
+Tensor matmul(const SparseTensor& a, const Tensor& b);
+Tensor matmul(const Tensor& a, const SparseTensor& b);
+
+// "coo", "csr", "bsr"
+const char* sparseFormatName(SparseFormat format);
+
+} // namespace tensor
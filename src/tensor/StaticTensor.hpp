@@ -0,0 +1,322 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+
+namespace detail {
+
+// Bis zu dieser Elementzahl werden Schleifen vollständig ausgerollt
+constexpr size_t UNROLL_LIMIT = 64;
+
+template <typename F, size_t... I>
+constexpr void unrollImpl(F& f, std::index_sequence<I...>) {
+    (f(I), ...);
+}
+
+// f(0), f(1), ..., f(N - 1); ausgerollt bis UNROLL_LIMIT, sonst als Schleife
+template <size_t N, typename F>
+constexpr void unroll(F&& f) {
+    if constexpr (N <= UNROLL_LIMIT) {
+        unrollImpl(f, std::make_index_sequence<N>{});
+    } else {
+        for (size_t i = 0; i < N; ++i) f(i);
+    }
+}
+
+// Zeilenweise Strides zu Dims (letzte Achse zusammenhängend)
+template <size_t... Dims>
+constexpr std::array<size_t, sizeof...(Dims)> rowMajorStrides() {
+    std::array<size_t, sizeof...(Dims)> dims = {Dims...};
+    std::array<size_t, sizeof...(Dims)> strides = {};
+    size_t stride = 1;
+    for (size_t d = sizeof...(Dims); d-- > 0;) {
+        strides[d] = stride;
+        stride *= dims[d];
+    }
+    return strides;
+}
+
+template <typename T>
+struct always_false : std::false_type {};
+
+// Passender Tensor-dtype für den Elementtyp (nur für die Umwandlung nötig)
+template <typename T>
+constexpr DType dtypeOf() {
+    if constexpr (std::is_same<T, float>::value) {
+        return DType::Float32;
+    } else if constexpr (std::is_same<T, double>::value) {
+        return DType::Float64;
+    } else if constexpr (std::is_same<T, int32_t>::value) {
+        return DType::Int32;
+    } else if constexpr (std::is_same<T, int8_t>::value) {
+        return DType::Int8;
+    } else {
+        static_assert(always_false<T>::value, "StaticTensor element type has no tensor dtype");
+        return DType::Float32;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Tensor mit fester, zur Compilezeit bekannter Shape
+ *
+ * Für kleine Matrizen und Vektoren (3x3/4x4-Transformationen, Merkmale
+ * pro Sample), bei denen Heap-Speicher, Laufzeit-Shapes und Prüfungen
+ * eines Tensor teurer sind als die Rechnung selbst. Die Elemente liegen
+ * direkt im Objekt (auf dem Stack), Shape und Strides sind constexpr,
+ * elementweise Operationen und matmul werden vollständig ausgerollt.
+ *
+ * Passen Shapes nicht zusammen, gibt es keinen Laufzeitfehler, sondern
+ * einen Compilefehler (a + b mit verschiedenen Dims, matmul mit
+ * unpassender innerer Dimension, Konstruktor mit falscher Werteanzahl).
+ *
+ *   StaticTensor<float, 3, 3> R = StaticTensor<float, 3, 3>::identity();
+ *   StaticTensor<float, 3> p(1.0f, 2.0f, 3.0f);
+ *   auto q = matmul(R, p) * 2.0f;
+ *   Tensor t = q.toTensor();
+ */
+template <typename T, size_t... Dims>
+class StaticTensor {
+    static_assert(std::is_arithmetic<T>::value, "StaticTensor needs an arithmetic element type");
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= Shape::MAX_RANK,
+                  "StaticTensor rank must be between 1 and Shape::MAX_RANK");
+    static_assert(((Dims > 0) && ...), "StaticTensor dimensions must be positive");
+
+public:
+    using value_type = T;
+
+    static constexpr size_t RANK = sizeof...(Dims);
+    static constexpr size_t SIZE = (Dims * ...);
+    static constexpr std::array<size_t, RANK> SHAPE = {Dims...};
+    static constexpr std::array<size_t, RANK> STRIDES = detail::rowMajorStrides<Dims...>();
+
+    // === Konstruktoren ===
+
+    // Mit 0 initialisiert
+    constexpr StaticTensor() : data_{} {}
+
+    // Alle Elemente zeilenweise; die Anzahl muss genau SIZE sein
+    template <typename... Values,
+              typename = std::enable_if_t<sizeof...(Values) == SIZE && (SIZE > 1) &&
+                                          (std::is_arithmetic<Values>::value && ...)>>
+    constexpr StaticTensor(Values... values) : data_{static_cast<T>(values)...} {}
+
+    static constexpr StaticTensor zeros() { return StaticTensor(); }
+    static constexpr StaticTensor ones() { return fill(T(1)); }
+
+    static constexpr StaticTensor fill(T value) {
+        StaticTensor result;
+        detail::unroll<SIZE>([&](size_t i) { result.data_[i] = value; });
+        return result;
+    }
+
+    static constexpr StaticTensor identity() {
+        static_assert(RANK == 2 && SHAPE[0] == SHAPE[1], "identity() needs a square matrix");
+        StaticTensor result;
+        detail::unroll<SHAPE[0]>([&](size_t i) { result.data_[i * (SHAPE[0] + 1)] = T(1); });
+        return result;
+    }
+
+    // === Eigenschaften ===
+
+    static constexpr size_t rank() { return RANK; }
+    static constexpr size_t size() { return SIZE; }
+    static Shape shape() { return Shape{Dims...}; }
+
+    constexpr T* data() { return data_.data(); }
+    constexpr const T* data() const { return data_.data(); }
+
+    // === Zugriff ===
+
+    // Flacher Index in zeilenweiser Reihenfolge
+    constexpr T& operator[](size_t index) { return data_[index]; }
+    constexpr const T& operator[](size_t index) const { return data_[index]; }
+
+    // Ein Index je Achse; geprüft wie bei Tensor nur mit TENSOR_BOUNDS_CHECK
+    template <typename... Indices>
+    constexpr T& operator()(Indices... indices) {
+        return data_[offset(indices...)];
+    }
+    template <typename... Indices>
+    constexpr const T& operator()(Indices... indices) const {
+        return data_[offset(indices...)];
+    }
+
+    // === Elementweise Operationen ===
+
+    template <typename F>
+    constexpr StaticTensor apply(F func) const {
+        StaticTensor result;
+        detail::unroll<SIZE>([&](size_t i) { result.data_[i] = func(data_[i]); });
+        return result;
+    }
+
+    constexpr StaticTensor operator-() const {
+        return apply([](T x) { return -x; });
+    }
+
+    constexpr StaticTensor& operator+=(const StaticTensor& other) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] += other.data_[i]; });
+        return *this;
+    }
+    constexpr StaticTensor& operator-=(const StaticTensor& other) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] -= other.data_[i]; });
+        return *this;
+    }
+    constexpr StaticTensor& operator*=(const StaticTensor& other) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] *= other.data_[i]; });
+        return *this;
+    }
+    constexpr StaticTensor& operator/=(const StaticTensor& other) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] /= other.data_[i]; });
+        return *this;
+    }
+
+    constexpr StaticTensor& operator+=(T scalar) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] += scalar; });
+        return *this;
+    }
+    constexpr StaticTensor& operator-=(T scalar) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] -= scalar; });
+        return *this;
+    }
+    constexpr StaticTensor& operator*=(T scalar) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] *= scalar; });
+        return *this;
+    }
+    constexpr StaticTensor& operator/=(T scalar) {
+        detail::unroll<SIZE>([&](size_t i) { data_[i] /= scalar; });
+        return *this;
+    }
+
+    // Nur gleiche Dims passen: a + b mit anderer Shape kompiliert nicht
+    friend constexpr StaticTensor operator+(StaticTensor a, const StaticTensor& b) { return a += b; }
+    friend constexpr StaticTensor operator-(StaticTensor a, const StaticTensor& b) { return a -= b; }
+    friend constexpr StaticTensor operator*(StaticTensor a, const StaticTensor& b) { return a *= b; }
+    friend constexpr StaticTensor operator/(StaticTensor a, const StaticTensor& b) { return a /= b; }
+
+    friend constexpr StaticTensor operator+(StaticTensor a, T scalar) { return a += scalar; }
+    friend constexpr StaticTensor operator-(StaticTensor a, T scalar) { return a -= scalar; }
+    friend constexpr StaticTensor operator*(StaticTensor a, T scalar) { return a *= scalar; }
+    friend constexpr StaticTensor operator/(StaticTensor a, T scalar) { return a /= scalar; }
+    friend constexpr StaticTensor operator+(T scalar, StaticTensor a) { return a += scalar; }
+    friend constexpr StaticTensor operator*(T scalar, StaticTensor a) { return a *= scalar; }
+
+    friend constexpr bool operator==(const StaticTensor& a, const StaticTensor& b) {
+        bool equal = true;
+        detail::unroll<SIZE>([&](size_t i) { equal = equal && a.data_[i] == b.data_[i]; });
+        return equal;
+    }
+    friend constexpr bool operator!=(const StaticTensor& a, const StaticTensor& b) { return !(a == b); }
+
+    // === Reduktionen und Matrix ===
+
+    constexpr T sum() const {
+        T total = T(0);
+        detail::unroll<SIZE>([&](size_t i) { total += data_[i]; });
+        return total;
+    }
+
+    constexpr T dot(const StaticTensor& other) const {
+        T total = T(0);
+        detail::unroll<SIZE>([&](size_t i) { total += data_[i] * other.data_[i]; });
+        return total;
+    }
+
+    constexpr auto transpose() const {
+        static_assert(RANK == 2, "transpose() needs a matrix");
+        constexpr size_t rows = SHAPE[0];
+        constexpr size_t cols = SHAPE[1];
+        StaticTensor<T, cols, rows> result;
+        detail::unroll<rows>([&](size_t i) {
+            detail::unroll<cols>([&](size_t j) { result[j * rows + i] = data_[i * cols + j]; });
+        });
+        return result;
+    }
+
+    // === Umwandlung in Tensor ===
+
+    // Eine Kopie der Elemente, keine Umrechnung für float
+    Tensor toTensor() const {
+        return Tensor::fromBytes(shape(), detail::dtypeOf<T>(), data_.data());
+    }
+
+    // Wirft std::invalid_argument, wenn die Shape nicht Dims entspricht;
+    // andere dtypes und Views werden dabei umgewandelt bzw. eingesammelt
+    static StaticTensor fromTensor(const Tensor& t) {
+        if (t.shape() != shape()) {
+            std::string dims;
+            for (size_t d : SHAPE) dims += (dims.empty() ? "" : ", ") + std::to_string(d);
+            throw std::invalid_argument("Cannot convert tensor of shape " + t.shapeString() +
+                                        " to StaticTensor of shape (" + dims + ")");
+        }
+        StaticTensor result;
+        t.to(detail::dtypeOf<T>()).copyTo(result.data_.data());
+        return result;
+    }
+
+private:
+    template <typename... Indices>
+    static constexpr size_t offset(Indices... indices) {
+        static_assert(sizeof...(Indices) == RANK, "StaticTensor needs one index per axis");
+        size_t result = 0;
+        size_t axis = 0;
+        ((
+#if TENSOR_BOUNDS_CHECK
+             static_cast<size_t>(indices) >= SHAPE[axis]
+                 ? throw std::out_of_range("StaticTensor index out of range")
+                 : void(),
+#endif
+             result += static_cast<size_t>(indices) * STRIDES[axis], ++axis),
+         ...);
+        return result;
+    }
+
+    std::array<T, SIZE> data_;
+};
+
+// === Matrixprodukte ===
+// Die innere Dimension wird zur Compilezeit geprüft
+
+template <typename T, size_t M, size_t K, size_t K2, size_t N>
+constexpr StaticTensor<T, M, N> matmul(const StaticTensor<T, M, K>& a, const StaticTensor<T, K2, N>& b) {
+    static_assert(K == K2, "matmul: inner dimensions must match");
+    StaticTensor<T, M, N> result;
+    // Zeile i von b-Zeilen aufsummieren: innerste Schleife zusammenhängend
+    detail::unroll<M>([&](size_t i) {
+        detail::unroll<K>([&](size_t k) {
+            const T aik = a[i * K + k];
+            detail::unroll<N>([&](size_t j) { result[i * N + j] += aik * b[k * N + j]; });
+        });
+    });
+    return result;
+}
+
+template <typename T, size_t M, size_t K, size_t K2>
+constexpr StaticTensor<T, M> matmul(const StaticTensor<T, M, K>& a, const StaticTensor<T, K2>& x) {
+    static_assert(K == K2, "matmul: matrix columns must match vector length");
+    StaticTensor<T, M> result;
+    detail::unroll<M>([&](size_t i) {
+        T total = T(0);
+        detail::unroll<K>([&](size_t k) { total += a[i * K + k] * x[k]; });
+        result[i] = total;
+    });
+    return result;
+}
+
+// Gängige Größen für Transformationen
+using Vec3 = StaticTensor<float, 3>;
+using Vec4 = StaticTensor<float, 4>;
+using Mat3 = StaticTensor<float, 3, 3>;
+using Mat4 = StaticTensor<float, 4, 4>;
+
+} // namespace tensor
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "tensor/Allocator.hpp"
+#include "tensor/DType.hpp"
+
+namespace tensor {
+
+/**
+ * @brief Referenzgezählter Datenpuffer eines Tensors
+ *
+ * Mehrere Tensoren können sich denselben Storage teilen (Views mit
+ * eigener Shape, eigenen Strides und Offset). Geschrieben wird erst
+ * nach einer Kopie, solange der Storage noch geteilt ist (Copy-on-Write).
+ *
+ * Der Puffer hat einen festen Elementtyp; Größe und Offsets zählen in
+ * Elementen, nicht in Bytes. Speicher kommt aus dem Allocator (auf 64
+ * Byte ausgerichtet, freigegebene Puffer werden wiederverwendet).
+ *
+ * Alternativ zeigt ein Storage auf fremden Speicher, z.B. eine gemappte
+ * Datei (MappedFile); owner hält ihn am Leben. Ist er nicht beschreibbar,
+ * kopiert jeder Schreibzugriff wie bei geteiltem Storage zuerst.
+ * reloadable: Der Inhalt steht vollständig in der Quelle, Seiten dürfen
+ * also verworfen und später neu geladen werden (geteilte Abbildung).
+ */
+class Storage {
+public:
+    using DataType = float;
+
+    // Uninitialisierter Puffer mit size Elementen vom Typ dtype
+    explicit Storage(size_t size, DType dtype = DType::Float32)
+        : data_(Allocator::instance().allocate(size * dtypeSize(dtype))),
+          size_(size), dtype_(dtype) {}
+
+    // Fremder Puffer, der so lange gültig bleibt, wie owner lebt
+    Storage(std::shared_ptr<const void> owner, void* data, size_t size, DType dtype,
+            bool writable, bool reloadable)
+        : data_(data), size_(size), dtype_(dtype), owner_(std::move(owner)),
+          writable_(writable), reloadable_(reloadable) {}
+
+    ~Storage() {
+        if (!owner_) Allocator::instance().deallocate(data_, nbytes());
+    }
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    // Nur für float32-Puffer
+    DataType* data() { return static_cast<DataType*>(data_); }
+    const DataType* data() const { return static_cast<const DataType*>(data_); }
+
+    void* raw() { return data_; }
+    const void* raw() const { return data_; }
+
+    size_t size() const { return size_; }
+    size_t nbytes() const { return size_ * dtypeSize(dtype_); }
+    DType dtype() const { return dtype_; }
+
+    bool external() const { return owner_ != nullptr; }
+    bool writable() const { return writable_; }
+    bool reloadable() const { return reloadable_; }
+
+private:
+    void* data_;
+    size_t size_;
+    DType dtype_;
+    std::shared_ptr<const void> owner_;
+    bool writable_ = true;
+    bool reloadable_ = false;
+};
+
+} // namespace tensor
@@ -0,0 +1,170 @@
+#include "tensor/Stream.hpp"
+#include <future>
+#include <limits>
+#include "tensor/MappedFile.hpp"
+
+namespace tensor {
+
+namespace {
+
+// Paging lohnt nur für Operanden, die den ganzen Bereich abdecken
+bool streamed(const Tensor& t, size_t n) {
+    return t.size() == n && t.isContiguous();
+}
+
+} // namespace
+
+// === Chunks ===
+
+size_t Stream::chunkElements(size_t bytesPerElement, size_t granularity) const {
+    granularity = std::max<size_t>(1, granularity);
+    // Mit Prefetch liegen aktueller und nächster Chunk gleichzeitig im Speicher
+    const size_t buffers = options_.prefetch ? 2 : 1;
+    size_t n = options_.memoryBudget / (buffers * std::max<size_t>(1, bytesPerElement));
+    n -= n % granularity;
+    return std::max(n, granularity);
+}
+
+void Stream::run(const std::vector<Tensor>& inputs, const std::vector<Tensor>& outputs, size_t n,
+                 size_t granularity, const std::function<void(size_t, size_t)>& body,
+                 size_t extraBytes) const {
+    if (n == 0) return;
+
+    size_t bytes = extraBytes;
+    for (const Tensor& t : inputs) {
+        if (streamed(t, n)) bytes += t.itemSize();
+    }
+    for (const Tensor& t : outputs) {
+        if (streamed(t, n)) bytes += t.itemSize();
+    }
+    const size_t chunk = chunkElements(bytes, granularity);
+
+    auto load = [&](size_t begin, size_t end) {
+        for (const Tensor& t : inputs) {
+            if (streamed(t, n)) MappedFile::load(t, begin, end - begin);
+        }
+    };
+
+    // Läuft höchstens ein Chunk voraus; wartet bei Ausnahmen im Destruktor
+    std::future<void> pending;
+    if (options_.prefetch) load(0, std::min(n, chunk));
+
+    for (size_t begin = 0; begin < n; begin += chunk) {
+        const size_t end = std::min(n, begin + chunk);
+        if (pending.valid()) pending.get();
+        if (options_.prefetch && end < n) {
+            pending = std::async(std::launch::async, load, end, std::min(n, end + chunk));
+        }
+
+        body(begin, end);
+
+        for (const Tensor& t : inputs) {
+            if (streamed(t, n)) MappedFile::release(t, begin, end - begin);
+        }
+        for (const Tensor& t : outputs) {
+            if (streamed(t, n)) MappedFile::release(t, begin, end - begin);
+        }
+    }
+}
+
+void Stream::forEachRows(const Tensor& t,
+                         const std::function<void(const Tensor&, size_t, size_t)>& body) const {
+    const size_t rows = t.shape()[0];
+    if (t.size() == 0) return;
+    const size_t rowSize = t.size() / rows;
+
+    // Andere dtypes und Views rechnen auf einer float32-Kopie je Chunk
+    const bool copies = t.dtype() != DType::Float32 || !t.isContiguous();
+    run({t}, {}, t.size(), rowSize, [&](size_t begin, size_t end) {
+        const size_t r0 = begin / rowSize;
+        const size_t r1 = end / rowSize;
+        body(t.slice(0, r0, r1), r0, r1);
+    }, copies ? sizeof(Tensor::DataType) : 0);
+}
+
+// === Reduktionen ===
+
+namespace {
+
+// Zusammenhängende Tensoren flach: Chunks unabhängig von der Zeilenlänge
+Tensor flatView(const Tensor& t) {
+    return t.isContiguous() ? t.reshape(Shape{t.size()}) : t;
+}
+
+} // namespace
+
+float Stream::sum(const Tensor& t) const {
+    if (t.size() == 0) return 0.0f;
+    double total = 0.0;
+    forEachRows(flatView(t), [&](const Tensor& part, size_t, size_t) {
+        const Tensor src = part.contiguousFloat();
+        const Tensor::DataType* in = src.base();
+        total += parallel_reduce(size_t(0), src.size(), 0, 0.0,
+            [in](size_t begin, size_t end) {
+                return static_cast<double>(reduce::sum(in + begin, end - begin));
+            },
+            std::plus<double>());
+    });
+    return static_cast<float>(total);
+}
+
+float Stream::mean(const Tensor& t) const {
+    // Wie Tensor::mean: leer NaN, sonst Welford aus stats(), bei NaN/Inf
+    // die naive Summe
+    if (t.size() == 0) return std::numeric_limits<float>::quiet_NaN();
+    Tensor::Stats s = stats(t);
+    if (!s.nanCount && !s.infCount) return s.mean;
+    return s.sum / static_cast<float>(t.size());
+}
+
+Tensor::Stats Stream::stats(const Tensor& t) const {
+    // Leer: count 0, min/max/mean/variance NaN
+    if (t.size() == 0) return Tensor::makeStats(reduce::Stats());
+    reduce::Stats total;
+    forEachRows(flatView(t), [&](const Tensor& part, size_t, size_t) {
+        const Tensor src = part.contiguousFloat();
+        const Tensor::DataType* in = src.base();
+        total = reduce::merge(total, parallel_reduce(size_t(0), src.size(), 0, reduce::Stats(),
+            [in](size_t begin, size_t end) {
+                return reduce::stats(in + begin, end - begin);
+            },
+            [](const reduce::Stats& a, const reduce::Stats& b) { return reduce::merge(a, b); }));
+    });
+    return Tensor::makeStats(total);
+}
+
+Tensor Stream::sum(const Tensor& t, size_t axis, bool keepdims) const {
+    if (axis >= t.rank()) throw std::out_of_range("Axis out of range");
+
+    Shape kept = t.shape();
+    kept[axis] = 1;
+    Tensor result = Tensor::zeros(kept);
+    if (axis == 0) {
+        // Teilsummen der Zeilenblöcke aufaddieren
+        forEachRows(t, [&](const Tensor& part, size_t, size_t) { result += part.sum(0, true); });
+    } else {
+        // Jeder Zeilenblock liefert seine eigenen Ergebniszeilen
+        const size_t rowSize = t.shape()[0] > 0 ? result.size() / t.shape()[0] : 0;
+        Tensor::DataType* out = result.base();
+        forEachRows(t, [&](const Tensor& part, size_t r0, size_t r1) {
+            const Tensor partial = part.sum(axis, true).contiguousFloat();
+            std::memcpy(out + r0 * rowSize, partial.base(), (r1 - r0) * rowSize * sizeof(Tensor::DataType));
+        });
+    }
+    if (keepdims) return result;
+
+    Shape reduced;
+    for (size_t d = 0; d < t.rank(); ++d) {
+        if (d != axis) reduced.push_back(t.shape()[d]);
+    }
+    if (reduced.empty()) reduced.push_back(1);
+    return result.reshape(reduced);
+}
+
+Tensor Stream::mean(const Tensor& t, size_t axis, bool keepdims) const {
+    Tensor result = sum(t, axis, keepdims);
+    result /= static_cast<Tensor::DataType>(t.shape()[axis]);
+    return result;
+}
+
+} // namespace tensor
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include "tensor/Reduce.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/Tensor.hpp"
+
+namespace tensor {
+
+struct StreamOptions {
+    // Obergrenze für gleichzeitig eingelagerte Daten aller Operanden
+    // (aktueller und vorausgeladener Chunk zusammen)
+    size_t memoryBudget = size_t(256) << 20;
+    // Nächsten Chunk in einem Hintergrund-Thread einlesen
+    bool prefetch = true;
+};
+
+/**
+ * @brief Chunkweise Ausführung für Tensoren größer als der Arbeitsspeicher
+ *
+ * Elementweise Ausdrücke und Reduktionen laufen in Stücken, die zusammen
+ * ins Budget passen: Chunk einlesen, rechnen, schreiben, freigeben.
+ * Während ein Chunk (parallel wie gewohnt) berechnet wird, lagert ein
+ * Hintergrund-Thread schon den nächsten ein; danach werden die Seiten
+ * des fertigen Chunks wieder verdrängt. Der residente Anteil bleibt so
+ * unabhängig von der Tensorgröße bei etwa memoryBudget.
+ *
+ * Ein- und Auslagern betrifft gemappte, zusammenhängende Tensoren (siehe
+ * MappedFile); Ergebnisse größer als der Speicher gehören in eine Datei
+ * aus MappedFile::create. Andere Tensoren rechnen einfach mit.
+ *
+ *   auto out = MappedFile::create("c.tmap", a.shape());
+ *   Tensor c = out->tensor();
+ *   Stream().assign(c, a * 2.0f + b);
+ */
+class Stream {
+public:
+    explicit Stream(const StreamOptions& options = {}) : options_(options) {}
+
+    const StreamOptions& options() const { return options_; }
+
+    // out = e; out braucht die Shape von e und behält seinen dtype.
+    // Wie bei +=: geschrieben wird in den Puffer von out, außer er ist
+    // nicht beschreibbar oder anderweitig geteilt (dann erst Kopie).
+    template <typename E>
+    void assign(Tensor& out, const expr::Expr<E>& e);
+    void assign(Tensor& out, const Tensor& t) { assign(out, expr::node(t)); }
+
+    // === Reduktionen (Ergebnis im Arbeitsspeicher) ===
+
+    float sum(const Tensor& t) const;
+    float mean(const Tensor& t) const;
+    Tensor::Stats stats(const Tensor& t) const;
+
+    template <typename E>
+    float sum(const expr::Expr<E>& e) const;
+
+    // Wie Tensor::sum/mean(axis, keepdims); Chunks aus ganzen Zeilen der Achse 0
+    Tensor sum(const Tensor& t, size_t axis, bool keepdims = false) const;
+    Tensor mean(const Tensor& t, size_t axis, bool keepdims = false) const;
+
+    // === Allgemein ===
+
+    // Elemente pro Chunk bei bytesPerElement Bytes je Element über alle
+    // Operanden; Vielfaches von granularity (mindestens granularity)
+    size_t chunkElements(size_t bytesPerElement, size_t granularity = 1) const;
+
+    // Ruft body(begin, end) für aufeinanderfolgende Chunks von [0, n) auf.
+    // inputs und outputs (je n Elemente) werden dabei ein- bzw. ausgelagert;
+    // inputs zusätzlich vorausgeladen. extraBytes: weiterer Speicher je
+    // Element, den body selbst belegt (z.B. Umwandlungspuffer).
+    void run(const std::vector<Tensor>& inputs, const std::vector<Tensor>& outputs, size_t n,
+             size_t granularity, const std::function<void(size_t, size_t)>& body,
+             size_t extraBytes = 0) const;
+
+private:
+    // Tensor in Blöcken ganzer Zeilen der Achse 0: body(part, r0, r1) mit
+    // part = t.slice(0, r0, r1); t braucht mindestens eine Achse
+    void forEachRows(const Tensor& t, const std::function<void(const Tensor&, size_t, size_t)>& body) const;
+
+    // Gemeinsamer Teil von assign/sum für Ausdrücke: Blätter in voller Größe
+    template <typename E>
+    static std::vector<Tensor> streamedLeaves(const E& e, size_t n);
+
+    StreamOptions options_;
+};
+
+// === Templates ===
+
+template <typename E>
+std::vector<Tensor> Stream::streamedLeaves(const E& e, size_t n) {
+    // Gebroadcastete Blätter (Zeilenvektoren, Skalare) sind klein und
+    // bleiben einfach eingelagert
+    std::vector<Tensor> leaves;
+    e.forEachLeaf([&](const expr::Leaf& leaf) {
+        if (leaf.tensor().size() == n && leaf.tensor().isContiguous()) leaves.push_back(leaf.tensor());
+    });
+    return leaves;
+}
+
+template <typename E>
+void Stream::assign(Tensor& out, const expr::Expr<E>& expression) {
+    const E& e = expression.self();
+    if (out.shape() != e.shape()) {
+        throw std::invalid_argument("Stream::assign: output shape " + out.shapeString() +
+                                    " does not match expression");
+    }
+
+    // Wie compoundAssign: ohne Kopie nur, wenn alle übrigen Besitzer
+    // Blätter mit exakt dieser Sicht sind
+    long sameView = 0;
+    bool foreignView = false;
+    e.forEachLeaf([&](const expr::Leaf& leaf) {
+        if (leaf.sameView(out)) {
+            ++sameView;
+        } else if (leaf.sharesStorage(out)) {
+            foreignView = true;
+        }
+    });
+    if (foreignView || !out.ownsStorage(1 + sameView)) {
+        out.detach();
+    } else {
+        out.markModified();
+    }
+
+    char* dst = out.rawBase();
+    const DType type = out.dtype();
+    const size_t item = out.itemSize();
+    run(streamedLeaves(e, out.size()), {out}, out.size(), 1, [&](size_t begin, size_t end) {
+        parallel_for(begin, end, 0, [&](size_t b, size_t en) {
+            alignas(64) Tensor::DataType buf[expr::BLOCK];
+            for (size_t i = b; i < en; i += expr::BLOCK) {
+                const size_t len = std::min(expr::BLOCK, en - i);
+                // Erst den ganzen Block berechnen: out darf zugleich Eingabe sein
+                const Tensor::DataType* src = e.block(i, len, buf);
+                char* target = dst + i * item;
+                if (type != DType::Float32) {
+                    convert(src, DType::Float32, target, type, len);
+                } else if (static_cast<const void*>(src) != target) {
+                    std::memcpy(target, src, len * sizeof(Tensor::DataType));
+                }
+            }
+        });
+    });
+}
+
+template <typename E>
+float Stream::sum(const expr::Expr<E>& expression) const {
+    const E& e = expression.self();
+    const size_t n = e.size();
+    double total = 0.0;
+    run(streamedLeaves(e, n), {}, n, 1, [&](size_t begin, size_t end) {
+        total += parallel_reduce(begin, end, 0, 0.0,
+            [&](size_t b, size_t en) {
+                alignas(64) Tensor::DataType buf[expr::BLOCK];
+                double acc = 0.0;
+                for (size_t i = b; i < en; i += expr::BLOCK) {
+                    const size_t len = std::min(expr::BLOCK, en - i);
+                    acc += reduce::sum(e.block(i, len, buf), len);
+                }
+                return acc;
+            },
+            std::plus<double>());
+    });
+    return static_cast<float>(total);
+}
+
+} // namespace tensor
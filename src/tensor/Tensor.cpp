@@ -1,66 +1,153 @@
 #include "tensor/Tensor.hpp"
+#include "tensor/Gemm.hpp"
+#include "tensor/NdIterator.hpp"
+#include "tensor/Permute.hpp"
+#include "tensor/Reduce.hpp"
+#include "tensor/Random.hpp"
+#include "tensor/Scheduler.hpp"
 #include <algorithm>
-#include <random>
+#include <atomic>
 #include <cassert>
+#include <cstring>
+#include <limits>
 
 namespace tensor {
 
+namespace {
+
+std::string formatShape(const Tensor::Shape& shape) {
+    std::ostringstream oss;
+    oss << "(";
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (i > 0) oss << ", ";
+        oss << shape[i];
+    }
+    oss << ")";
+    return oss.str();
+}
+
+// Achsen prüfen, sortieren und Duplikate entfernen
+std::vector<size_t> normalizeAxes(const std::vector<size_t>& axes, size_t rank) {
+    std::vector<size_t> sorted = axes;
+    for (size_t a : sorted) {
+        if (a >= rank) throw std::out_of_range("Axis out of range");
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return sorted;
+}
+
+} // namespace
+
 // === Konstruktoren ===
 
-Tensor::Tensor() : shape_(), strides_(), data_() {}
+Tensor::Tensor() : shape_(), strides_(), storage_(), size_(0) {}
 
-Tensor::Tensor(DataType value) : shape_(), strides_(), data_({value}) {}
+Tensor::Tensor(DataType value)
+    : shape_(), strides_(), storage_(std::make_shared<Storage>(1)), size_(1) {
+    storage_->data()[0] = value;
+}
 
 Tensor::Tensor(const Shape& shape) : shape_(shape) {
     validateShape(shape);
     computeStrides();
-    size_t totalSize = shape.empty() ? 1 : strides_[0] * shape[0];
-    data_.resize(totalSize, 0.0f);
+    size_ = shape.empty() ? 1 : strides_[0] * shape[0];
+    storage_ = std::make_shared<Storage>(size_);
+    DataType* out = storage_->data();
+    parallel_for(0, size_, 0, [=](size_t begin, size_t end) {
+        std::fill(out + begin, out + end, 0.0f);
+    });
 }
 
 Tensor::Tensor(const Shape& shape, const std::vector<DataType>& data)
-    : shape_(shape), data_(data) {
+    : shape_(shape) {
     validateShape(shape);
     computeStrides();
-    size_t expectedSize = shape.empty() ? 1 : strides_[0] * shape[0];
-    if (data.size() != expectedSize) {
+    size_ = shape.empty() ? 1 : strides_[0] * shape[0];
+    if (data.size() != size_) {
         throw std::invalid_argument("Data size doesn't match shape");
     }
+    storage_ = std::make_shared<Storage>(size_);
+    std::copy(data.begin(), data.end(), storage_->data());
 }
 
 Tensor::Tensor(const Shape& shape, std::function<DataType(size_t)> initializer)
     : shape_(shape) {
     validateShape(shape);
     computeStrides();
-    size_t totalSize = shape.empty() ? 1 : strides_[0] * shape[0];
-    data_.resize(totalSize);
-    for (size_t i = 0; i < totalSize; ++i) {
-        data_[i] = initializer(i);
+    size_ = shape.empty() ? 1 : strides_[0] * shape[0];
+    storage_ = std::make_shared<Storage>(size_);
+    DataType* out = storage_->data();
+    for (size_t i = 0; i < size_; ++i) {
+        out[i] = initializer(i);
     }
 }
 
+Tensor::Tensor(std::shared_ptr<Storage> storage, const Shape& shape,
+               const Strides& strides, size_t offset)
+    : shape_(shape), strides_(strides), storage_(std::move(storage)), offset_(offset) {
+    size_ = 1;
+    for (size_t d : shape_) size_ *= d;
+    updateContiguous();
+}
+
+Tensor Tensor::uninitialized(const Shape& shape, DType dtype) {
+    Tensor t;
+    t.validateShape(shape);
+    t.shape_ = shape;
+    t.computeStrides();
+    t.size_ = shape.empty() ? 1 : t.strides_[0] * shape[0];
+    t.storage_ = std::make_shared<Storage>(t.size_, dtype);
+    return t;
+}
+
 // === Fabrikmethoden ===
 
-Tensor Tensor::zeros(const Shape& shape) {
-    return Tensor(shape);
+Tensor Tensor::zeros(const Shape& shape, DType dtype) {
+    if (dtype == DType::Float32) return Tensor(shape);
+
+    // Null ist in allen Typen das Bitmuster aus Nullen
+    Tensor t = uninitialized(shape, dtype);
+    char* out = t.rawBase();
+    size_t item = t.itemSize();
+    parallel_for(0, t.size_, 0, [=](size_t begin, size_t end) {
+        std::memset(out + begin * item, 0, (end - begin) * item);
+    });
+    return t;
 }
 
-Tensor Tensor::ones(const Shape& shape) {
-    return fill(shape, 1.0f);
+Tensor Tensor::ones(const Shape& shape, DType dtype) {
+    return fill(shape, 1.0f, dtype);
 }
 
-Tensor Tensor::fill(const Shape& shape, DataType value) {
-    Tensor t(shape);
-    std::fill(t.data_.begin(), t.data_.end(), value);
+Tensor Tensor::fill(const Shape& shape, DataType value, DType dtype) {
+    if (dtype == DType::Float32) {
+        Tensor t(shape);
+        DataType* out = t.base();
+        parallel_for(0, t.size(), 0, [=](size_t begin, size_t end) {
+            std::fill(out + begin, out + end, value);
+        });
+        return t;
+    }
+
+    // Wert einmal umwandeln, dann das Bitmuster vervielfältigen
+    Tensor t = uninitialized(shape, dtype);
+    char pattern[8];
+    storeFromFloat(value, pattern, dtype);
+    char* out = t.rawBase();
+    size_t item = t.itemSize();
+    parallel_for(0, t.size_, 0, [=, &pattern](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) std::memcpy(out + i * item, pattern, item);
+    });
     return t;
 }
 
 Tensor Tensor::random(const Shape& shape, DataType min, DataType max) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<DataType> dist(min, max);
+    return Generator::global().uniform(shape, min, max);
+}
 
-    return Tensor(shape, [&](size_t) { return dist(gen); });
+Tensor Tensor::randn(const Shape& shape, DataType mean, DataType stddev) {
+    return Generator::global().normal(shape, mean, stddev);
 }
 
 Tensor Tensor::range(DataType start, DataType end, DataType step) {
@@ -73,8 +160,9 @@ Tensor Tensor::range(DataType start, DataType end, DataType step) {
 
 Tensor Tensor::identity(size_t n) {
     Tensor t({n, n});
+    DataType* out = t.base();
     for (size_t i = 0; i < n; ++i) {
-        t.at(i, i) = 1.0f;
+        out[i * n + i] = 1.0f;
     }
     return t;
 }
@@ -98,6 +186,12 @@ Tensor Tensor::fromMatrix(const std::vector<std::vector<DataType>>& mat) {
     return Tensor({rows, cols}, data);
 }
 
+Tensor Tensor::fromBytes(const Shape& shape, DType dtype, const void* bytes) {
+    Tensor t = uninitialized(shape, dtype);
+    std::memcpy(t.rawBase(), bytes, t.nbytes());
+    return t;
+}
+
 // === Eigenschaften ===
 
 size_t Tensor::dim(size_t axis) const {
@@ -107,40 +201,109 @@ size_t Tensor::dim(size_t axis) const {
     return shape_[axis];
 }
 
+bool Tensor::sharesStorage(const Tensor& other) const {
+    return storage_ && storage_ == other.storage_;
+}
+
+Tensor Tensor::contiguous() const {
+    if (contiguous_) {
+        // Strides von Größe-1-Achsen vereinheitlichen, Daten bleiben geteilt
+        Tensor result(*this);
+        result.computeStrides();
+        return result;
+    }
+    Tensor result(std::make_shared<Storage>(size_, dtype()), shape_, strides_, 0);
+    result.computeStrides();
+    copyTo(result.rawBase());
+    return result;
+}
+
+Tensor Tensor::to(DType dtype) const {
+    if (!storage_ || dtype == this->dtype()) return *this;
+
+    const Tensor src = contiguous();
+    Tensor result = uninitialized(shape_, dtype);
+    const char* in = src.rawBase();
+    char* out = result.rawBase();
+    DType from = src.dtype();
+    size_t inItem = src.itemSize();
+    size_t outItem = result.itemSize();
+    parallel_for(0, size_, 0, [=](size_t begin, size_t end) {
+        convert(in + begin * inItem, from, out + begin * outItem, dtype, end - begin);
+    });
+    return result;
+}
+
 // === Datenzugriff ===
 
+Tensor::DataType Tensor::value(size_t index) const {
+    if (index >= size_) throw std::out_of_range("Index out of bounds");
+    return loadAsFloat(rawBase() + storageIndex(index) * itemSize(), dtype());
+}
+
+void Tensor::copyBytes(void* dst) const {
+    copyTo(dst);
+}
+
 Tensor::DataType& Tensor::operator[](size_t index) {
-    return data_[index];
+    requireFloat();
+    detach();
+    return base()[index];
 }
 
 const Tensor::DataType& Tensor::operator[](size_t index) const {
-    return data_[index];
+    requireFloat();
+    return base()[storageIndex(index)];
+}
+
+Tensor::DataType* Tensor::data() {
+    requireFloat();
+    detach();
+    return storage_ ? base() : nullptr;
+}
+
+const Tensor::DataType* Tensor::data() const {
+    requireFloat();
+    return storage_ ? base() : nullptr;
 }
 
-Tensor::DataType& Tensor::at(const std::vector<size_t>& indices) {
+Tensor::DataType& Tensor::at(const Shape& indices) {
     validateIndices(indices);
-    return data_[flatIndex(indices)];
+    requireFloat();
+    detach();
+    return base()[flatIndex(indices)];
 }
 
-const Tensor::DataType& Tensor::at(const std::vector<size_t>& indices) const {
+const Tensor::DataType& Tensor::at(const Shape& indices) const {
     validateIndices(indices);
-    return data_[flatIndex(indices)];
+    requireFloat();
+    return base()[flatIndex(indices)];
 }
 
 Tensor::DataType& Tensor::at(size_t row, size_t col) {
-    return at({row, col});
+    validateIndices({row, col});
+    requireFloat();
+    detach();
+    return base()[row * strides_[0] + col * strides_[1]];
 }
 
 const Tensor::DataType& Tensor::at(size_t row, size_t col) const {
-    return at({row, col});
+    validateIndices({row, col});
+    requireFloat();
+    return base()[row * strides_[0] + col * strides_[1]];
 }
 
 Tensor::DataType& Tensor::at(size_t i, size_t j, size_t k) {
-    return at({i, j, k});
+    validateIndices({i, j, k});
+    requireFloat();
+    detach();
+    return base()[i * strides_[0] + j * strides_[1] + k * strides_[2]];
 }
 
 const Tensor::DataType& Tensor::at(size_t i, size_t j, size_t k) const {
-    return at({i, j, k});
+    validateIndices({i, j, k});
+    requireFloat();
+    return base()[i * strides_[0] + j * strides_[1] + k * strides_[2]];
 }
 
 // === Umformung ===
@@ -148,56 +311,61 @@ const Tensor::DataType& Tensor::at(size_t i, size_t j, size_t k) const {
 Tensor Tensor::reshape(const Shape& newShape) const {
     size_t newSize = 1;
     for (size_t d : newShape) newSize *= d;
-    if (newSize != data_.size()) {
+    if (newSize != size_) {
         throw std::invalid_argument("Cannot reshape: incompatible sizes");
     }
-    return Tensor(newShape, data_);
+    validateShape(newShape);
+
+    // Nur zusammenhängende Daten lassen sich ohne Kopie neu interpretieren
+    Tensor result = contiguous();
+    result.shape_ = newShape;
+    result.computeStrides();
+    return result;
 }
 
 Tensor Tensor::flatten() const {
-    return Tensor({data_.size()}, data_);
+    return reshape({size_});
 }
 
 Tensor Tensor::transpose() const {
     if (rank() != 2) {
         throw std::invalid_argument("transpose() without args only for 2D tensors");
     }
-    Tensor result({shape_[1], shape_[0]});
-    for (size_t i = 0; i < shape_[0]; ++i) {
-        for (size_t j = 0; j < shape_[1]; ++j) {
-            result.at(j, i) = at(i, j);
-        }
-    }
-    return result;
+    return transpose({1, 0});
 }
 
 Tensor Tensor::transpose(const std::vector<size_t>& axes) const {
     if (axes.size() != rank()) {
         throw std::invalid_argument("Axes must match tensor rank");
     }
+    std::vector<bool> seen(rank(), false);
     Shape newShape(rank());
+    Strides newStrides(rank());
     for (size_t i = 0; i < rank(); ++i) {
-        newShape[i] = shape_[axes[i]];
-    }
-    Tensor result(newShape);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        auto oldIdx = unflatIndex(i);
-        std::vector<size_t> newIdx(rank());
-        for (size_t j = 0; j < rank(); ++j) {
-            newIdx[j] = oldIdx[axes[j]];
+        if (axes[i] >= rank() || seen[axes[i]]) {
+            throw std::invalid_argument("Axes must be a permutation");
         }
-        result.at(newIdx) = data_[i];
+        seen[axes[i]] = true;
+        newShape[i] = shape_[axes[i]];
+        newStrides[i] = strides_[axes[i]];
     }
-    return result;
+    return Tensor(storage_, newShape, newStrides, offset_);
 }
 
 Tensor Tensor::squeeze() const {
     Shape newShape;
-    for (size_t d : shape_) {
-        if (d != 1) newShape.push_back(d);
+    Strides newStrides;
+    for (size_t i = 0; i < rank(); ++i) {
+        if (shape_[i] != 1) {
+            newShape.push_back(shape_[i]);
+            newStrides.push_back(strides_[i]);
+        }
+    }
+    if (newShape.empty()) {
+        newShape.push_back(1);
+        newStrides.push_back(1);
     }
-    if (newShape.empty()) newShape.push_back(1);
-    return reshape(newShape);
+    return Tensor(storage_, newShape, newStrides, offset_);
 }
 
 Tensor Tensor::unsqueeze(size_t axis) const {
@@ -205,8 +373,48 @@ Tensor Tensor::unsqueeze(size_t axis) const {
         throw std::out_of_range("Axis out of range for unsqueeze");
     }
     Shape newShape = shape_;
+    Strides newStrides = strides_;
+    size_t stride = axis < rank() ? shape_[axis] * strides_[axis] : 1;
     newShape.insert(newShape.begin() + axis, 1);
-    return reshape(newShape);
+    newStrides.insert(newStrides.begin() + axis, stride);
+    return Tensor(storage_, newShape, newStrides, offset_);
+}
+
+Tensor Tensor::expand(const Shape& shape) const {
+    if (shape.size() < rank()) {
+        throw std::invalid_argument("Cannot expand " + shapeString() + " to " + formatShape(shape));
+    }
+
+    // Rechtsbündig ausrichten; gestreckte und neue Achsen lesen immer dasselbe Element
+    size_t lead = shape.size() - rank();
+    Strides newStrides(shape.size(), 0);
+    for (size_t i = 0; i < rank(); ++i) {
+        if (shape_[i] == shape[lead + i]) {
+            newStrides[lead + i] = strides_[i];
+        } else if (shape_[i] != 1) {
+            throw std::invalid_argument("Cannot expand " + shapeString() + " to " + formatShape(shape));
+        }
+    }
+    validateShape(shape);
+    return Tensor(storage_, shape, newStrides, offset_);
+}
+
+Tensor::Shape Tensor::broadcastShapes(const Shape& a, const Shape& b) {
+    const Shape& longer = a.size() >= b.size() ? a : b;
+    const Shape& shorter = a.size() >= b.size() ? b : a;
+    size_t lead = longer.size() - shorter.size();
+
+    Shape result = longer;
+    for (size_t i = 0; i < shorter.size(); ++i) {
+        size_t x = longer[lead + i];
+        size_t y = shorter[i];
+        if (x != y && x != 1 && y != 1) {
+            throw std::invalid_argument("Shapes " + formatShape(a) + " and " +
+                                        formatShape(b) + " cannot be broadcast");
+        }
+        result[lead + i] = std::max(x, y);
+    }
+    return result;
 }
 
 // === Slicing ===
@@ -219,15 +427,7 @@ Tensor Tensor::slice(size_t axis, size_t start, size_t end) const {
 
     Shape newShape = shape_;
     newShape[axis] = end - start;
-    Tensor result(newShape);
-
-    // Iteriere durch alle Indizes
-    for (size_t i = 0; i < result.size(); ++i) {
-        auto idx = result.unflatIndex(i);
-        idx[axis] += start;
-        result[i] = at(idx);
-    }
-    return result;
+    return Tensor(storage_, newShape, strides_, offset_ + start * strides_[axis]);
 }
 
 Tensor Tensor::row(size_t i) const {
@@ -242,245 +442,376 @@ Tensor Tensor::col(size_t j) const {
 
 // === Elementweise Operationen ===
 
-Tensor Tensor::operator+(const Tensor& other) const {
-    if (shape_ != other.shape_) {
-        throw std::invalid_argument("Shape mismatch for addition");
-    }
-    Tensor result(shape_);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        result[i] = data_[i] + other[i];
-    }
-    return result;
+Tensor& Tensor::operator+=(const Tensor& other) {
+    return compoundAssign<expr::AddOp>(expr::Leaf(other));
 }
 
-Tensor Tensor::operator-(const Tensor& other) const {
-    if (shape_ != other.shape_) {
-        throw std::invalid_argument("Shape mismatch for subtraction");
-    }
-    Tensor result(shape_);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        result[i] = data_[i] - other[i];
-    }
-    return result;
+Tensor& Tensor::operator-=(const Tensor& other) {
+    return compoundAssign<expr::SubOp>(expr::Leaf(other));
 }
 
-Tensor Tensor::operator*(const Tensor& other) const {
-    if (shape_ != other.shape_) {
-        throw std::invalid_argument("Shape mismatch for multiplication");
-    }
-    Tensor result(shape_);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        result[i] = data_[i] * other[i];
-    }
-    return result;
+Tensor& Tensor::operator*=(const Tensor& other) {
+    return compoundAssign<expr::MulOp>(expr::Leaf(other));
 }
 
-Tensor Tensor::operator/(const Tensor& other) const {
-    if (shape_ != other.shape_) {
-        throw std::invalid_argument("Shape mismatch for division");
-    }
-    Tensor result(shape_);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        result[i] = data_[i] / other[i];
-    }
-    return result;
+Tensor& Tensor::operator/=(const Tensor& other) {
+    return compoundAssign<expr::DivOp>(expr::Leaf(other));
 }
 
-Tensor Tensor::operator+(DataType scalar) const {
-    return apply([scalar](DataType x) { return x + scalar; });
+Tensor& Tensor::operator+=(DataType scalar) {
+    return compoundAssign<expr::AddOp>(expr::Scalar(scalar));
 }
 
-Tensor Tensor::operator-(DataType scalar) const {
-    return apply([scalar](DataType x) { return x - scalar; });
+Tensor& Tensor::operator-=(DataType scalar) {
+    return compoundAssign<expr::SubOp>(expr::Scalar(scalar));
 }
 
-Tensor Tensor::operator*(DataType scalar) const {
-    return apply([scalar](DataType x) { return x * scalar; });
+Tensor& Tensor::operator*=(DataType scalar) {
+    return compoundAssign<expr::MulOp>(expr::Scalar(scalar));
 }
 
-Tensor Tensor::operator/(DataType scalar) const {
-    return apply([scalar](DataType x) { return x / scalar; });
+Tensor& Tensor::operator/=(DataType scalar) {
+    return compoundAssign<expr::DivOp>(expr::Scalar(scalar));
 }
 
-Tensor& Tensor::operator+=(const Tensor& other) {
-    *this = *this + other;
-    return *this;
-}
+// === Reduktionen ===
 
-Tensor& Tensor::operator-=(const Tensor& other) {
-    *this = *this - other;
-    return *this;
+Tensor::DataType Tensor::sum() const {
+    // Ohne NaN/Inf aus stats() (zwischengespeichert), sonst direkt
+    if (size_ > 0) {
+        Stats s = stats();
+        if (!s.nanCount && !s.infCount) return s.sum;
+    }
+    if (!storage_ || size_ == 0) return DataType(0);
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    return parallel_reduce(size_t(0), size_, 0, DataType(0),
+        [in](size_t begin, size_t end) {
+            return reduce::sum(in + begin, end - begin);
+        },
+        std::plus<DataType>());
 }
 
-Tensor& Tensor::operator*=(const Tensor& other) {
-    *this = *this * other;
-    return *this;
+Tensor::DataType Tensor::mean() const {
+    if (size_ > 0) {
+        Stats s = stats();
+        if (!s.nanCount && !s.infCount) return s.mean;
+    }
+    return sum() / static_cast<DataType>(size_);
 }
 
-Tensor& Tensor::operator/=(const Tensor& other) {
-    *this = *this / other;
-    return *this;
+Tensor::DataType Tensor::min() const {
+    if (size_ > 0) {
+        Stats s = stats();
+        if (!s.nanCount && !s.infCount) return s.min;
+    }
+    if (!storage_ || size_ == 0) return std::numeric_limits<DataType>::quiet_NaN();
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    return parallel_reduce(size_t(0), size_, 0, std::numeric_limits<DataType>::max(),
+        [in](size_t begin, size_t end) {
+            return reduce::min(in + begin, end - begin);
+        },
+        [](DataType a, DataType b) { return std::min(a, b); });
 }
 
-Tensor Tensor::operator-() const {
-    return apply([](DataType x) { return -x; });
+Tensor::DataType Tensor::max() const {
+    if (size_ > 0) {
+        Stats s = stats();
+        if (!s.nanCount && !s.infCount) return s.max;
+    }
+    if (!storage_ || size_ == 0) return std::numeric_limits<DataType>::quiet_NaN();
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    return parallel_reduce(size_t(0), size_, 0, std::numeric_limits<DataType>::lowest(),
+        [in](size_t begin, size_t end) {
+            return reduce::max(in + begin, end - begin);
+        },
+        [](DataType a, DataType b) { return std::max(a, b); });
 }
 
-// === Elementweise Funktionen ===
-
-Tensor Tensor::apply(std::function<DataType(DataType)> func) const {
-    Tensor result(shape_);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        result[i] = func(data_[i]);
+Tensor::DataType Tensor::prod() const {
+    if (!storage_ || size_ == 0) return DataType(1);
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    return parallel_reduce(size_t(0), size_, 0, DataType(1),
+        [in](size_t begin, size_t end) {
+            return reduce::prod(in + begin, end - begin);
+        },
+        std::multiplies<DataType>());
+}
+
+Tensor::DataType Tensor::var() const {
+    // Ein Durchlauf über stats(); NaN/Inf im Tensor machen die Varianz NaN
+    Stats s = stats();
+    if (s.nanCount || s.infCount) return std::numeric_limits<DataType>::quiet_NaN();
+    return s.variance;
+}
+
+Tensor::DataType Tensor::stddev() const {
+    return std::sqrt(var());
+}
+
+Tensor::Stats Tensor::stats() const {
+    // Kopien teilen den Cache-Zeiger; ersetzt wird er nur als Ganzes
+    std::shared_ptr<const StatsCache> cached = std::atomic_load(&statsCache_);
+    if (cached && cached->version == version_) return cached->stats;
+    Stats s = computeStats();
+    std::atomic_store(&statsCache_, std::shared_ptr<const StatsCache>(
+        std::make_shared<StatsCache>(StatsCache{version_, s})));
+    return s;
+}
+
+Tensor::Stats Tensor::computeStats() const {
+    // Leerer Tensor: count 0, min/max/mean/variance NaN
+    if (!storage_ || size_ == 0) return makeStats(reduce::Stats());
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    reduce::Stats r = parallel_reduce(size_t(0), size_, 0, reduce::Stats(),
+        [in](size_t begin, size_t end) {
+            return reduce::stats(in + begin, end - begin);
+        },
+        [](const reduce::Stats& a, const reduce::Stats& b) { return reduce::merge(a, b); });
+    return makeStats(r);
+}
+
+Tensor::Stats Tensor::makeStats(const reduce::Stats& r) {
+    Stats s;
+    s.count = r.count;
+    s.nanCount = r.nanCount;
+    s.infCount = r.infCount;
+    s.sum = static_cast<DataType>(r.sum);
+    if (r.count == 0) {
+        s.min = s.max = s.mean = s.variance = std::numeric_limits<DataType>::quiet_NaN();
+        return s;
     }
-    return result;
+    s.min = r.min;
+    s.max = r.max;
+    s.mean = static_cast<DataType>(r.mean);
+    s.variance = static_cast<DataType>(r.m2 / static_cast<double>(r.count));
+    return s;
 }
 
-Tensor Tensor::sqrt() const {
-    return apply([](DataType x) { return std::sqrt(x); });
+size_t Tensor::argmin() const {
+    if (size_ == 0) throw std::invalid_argument("argmin of empty tensor");
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    using Best = std::pair<DataType, size_t>;
+    return parallel_reduce(size_t(0), size_, 0, Best(in[0], 0),
+        [in](size_t begin, size_t end) {
+            size_t i = begin + reduce::argmin(in + begin, end - begin);
+            return Best(in[i], i);
+        },
+        [](const Best& a, const Best& b) { return b.first < a.first ? b : a; }).second;
 }
 
-Tensor Tensor::pow(DataType exponent) const {
-    return apply([exponent](DataType x) { return std::pow(x, exponent); });
+size_t Tensor::argmax() const {
+    if (size_ == 0) throw std::invalid_argument("argmax of empty tensor");
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    using Best = std::pair<DataType, size_t>;
+    return parallel_reduce(size_t(0), size_, 0, Best(in[0], 0),
+        [in](size_t begin, size_t end) {
+            size_t i = begin + reduce::argmax(in + begin, end - begin);
+            return Best(in[i], i);
+        },
+        [](const Best& a, const Best& b) { return b.first > a.first ? b : a; }).second;
 }
 
-Tensor Tensor::exp() const {
-    return apply([](DataType x) { return std::exp(x); });
+Tensor Tensor::sum(size_t axis, bool keepdims) const {
+    return sum(std::vector<size_t>{axis}, keepdims);
 }
 
-Tensor Tensor::log() const {
-    return apply([](DataType x) { return std::log(x); });
+Tensor Tensor::mean(size_t axis, bool keepdims) const {
+    return mean(std::vector<size_t>{axis}, keepdims);
 }
 
-Tensor Tensor::abs() const {
-    return apply([](DataType x) { return std::abs(x); });
+Tensor Tensor::min(size_t axis, bool keepdims) const {
+    return min(std::vector<size_t>{axis}, keepdims);
 }
 
-Tensor Tensor::sin() const {
-    return apply([](DataType x) { return std::sin(x); });
+Tensor Tensor::max(size_t axis, bool keepdims) const {
+    return max(std::vector<size_t>{axis}, keepdims);
 }
 
-Tensor Tensor::cos() const {
-    return apply([](DataType x) { return std::cos(x); });
+Tensor Tensor::var(size_t axis, bool keepdims) const {
+    return var(std::vector<size_t>{axis}, keepdims);
 }
 
-// === Reduktionen ===
-
-Tensor::DataType Tensor::sum() const {
-    return std::accumulate(data_.begin(), data_.end(), DataType(0));
+Tensor Tensor::stddev(size_t axis, bool keepdims) const {
+    return stddev(std::vector<size_t>{axis}, keepdims);
 }
 
-Tensor::DataType Tensor::mean() const {
-    return sum() / static_cast<DataType>(data_.size());
+Tensor Tensor::sum(const std::vector<size_t>& axes, bool keepdims) const {
+    return reduceAxes(reduce::Op::Sum, normalizeAxes(axes, rank()), keepdims);
 }
 
-Tensor::DataType Tensor::min() const {
-    return *std::min_element(data_.begin(), data_.end());
+Tensor Tensor::mean(const std::vector<size_t>& axes, bool keepdims) const {
+    std::vector<size_t> sorted = normalizeAxes(axes, rank());
+    size_t count = 1;
+    for (size_t a : sorted) count *= shape_[a];
+    Tensor result = reduceAxes(reduce::Op::Sum, sorted, keepdims);
+    result /= static_cast<DataType>(count);
+    return result;
 }
 
-Tensor::DataType Tensor::max() const {
-    return *std::max_element(data_.begin(), data_.end());
+Tensor Tensor::min(const std::vector<size_t>& axes, bool keepdims) const {
+    return reduceAxes(reduce::Op::Min, normalizeAxes(axes, rank()), keepdims);
 }
 
-Tensor::DataType Tensor::prod() const {
-    return std::accumulate(data_.begin(), data_.end(), DataType(1),
-                           std::multiplies<DataType>());
+Tensor Tensor::max(const std::vector<size_t>& axes, bool keepdims) const {
+    return reduceAxes(reduce::Op::Max, normalizeAxes(axes, rank()), keepdims);
 }
 
-Tensor Tensor::sum(size_t axis) const {
-    if (axis >= rank()) throw std::out_of_range("Axis out of range");
-
-    Shape newShape;
-    for (size_t i = 0; i < rank(); ++i) {
-        if (i != axis) newShape.push_back(shape_[i]);
-    }
-    if (newShape.empty()) newShape.push_back(1);
+Tensor Tensor::var(const std::vector<size_t>& axes, bool keepdims) const {
+    // Abweichungen vom per Broadcasting abgezogenen Mittelwert, dann mitteln
+    Tensor centered = (*this - mean(axes, true)).pow(2.0f);
+    return centered.mean(axes, keepdims);
+}
 
-    Tensor result = Tensor::zeros(newShape);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        auto idx = unflatIndex(i);
-        std::vector<size_t> newIdx;
-        for (size_t j = 0; j < idx.size(); ++j) {
-            if (j != axis) newIdx.push_back(idx[j]);
-        }
-        if (newIdx.empty()) newIdx.push_back(0);
-        result.at(newIdx) += data_[i];
-    }
+Tensor Tensor::stddev(const std::vector<size_t>& axes, bool keepdims) const {
+    Tensor result = var(axes, keepdims);
+    DataType* out = result.base();
+    vmath::sqrt(out, out, result.size_);
     return result;
 }
 
-Tensor Tensor::mean(size_t axis) const {
-    return sum(axis) / static_cast<DataType>(shape_[axis]);
+Tensor Tensor::argmin(size_t axis, bool keepdims) const {
+    return argReduce(false, axis, keepdims);
 }
 
-Tensor Tensor::min(size_t axis) const {
-    if (axis >= rank()) throw std::out_of_range("Axis out of range");
+Tensor Tensor::argmax(size_t axis, bool keepdims) const {
+    return argReduce(true, axis, keepdims);
+}
 
-    Shape newShape;
-    for (size_t i = 0; i < rank(); ++i) {
-        if (i != axis) newShape.push_back(shape_[i]);
+Tensor Tensor::reduceAxes(reduce::Op op, const std::vector<size_t>& axes, bool keepdims) const {
+    Tensor current = contiguousFloat();
+    Shape kept = shape_;
+
+    // Benachbarte Achsen als eine Achse reduzieren, von hinten nach vorne
+    for (size_t i = axes.size(); i > 0;) {
+        size_t last = axes[--i];
+        size_t first = last;
+        while (i > 0 && axes[i - 1] == first - 1) first = axes[--i];
+
+        size_t outer = 1, n = 1, inner = 1;
+        for (size_t d = 0; d < first; ++d) outer *= kept[d];
+        for (size_t d = first; d <= last; ++d) n *= kept[d];
+        for (size_t d = last + 1; d < kept.size(); ++d) inner *= kept[d];
+        for (size_t d = first; d <= last; ++d) kept[d] = 1;
+
+        Tensor next = uninitialized(kept);
+        reduce::axis(op, current.base(), next.base(), outer, n, inner);
+        current = std::move(next);
     }
-    if (newShape.empty()) newShape.push_back(1);
 
-    Tensor result = Tensor::fill(newShape, std::numeric_limits<DataType>::max());
-    for (size_t i = 0; i < data_.size(); ++i) {
-        auto idx = unflatIndex(i);
-        std::vector<size_t> newIdx;
-        for (size_t j = 0; j < idx.size(); ++j) {
-            if (j != axis) newIdx.push_back(idx[j]);
-        }
-        if (newIdx.empty()) newIdx.push_back(0);
-        result.at(newIdx) = std::min(result.at(newIdx), data_[i]);
+    if (keepdims) return current;
+
+    Shape reduced;
+    for (size_t d = 0; d < rank(); ++d) {
+        if (!std::binary_search(axes.begin(), axes.end(), d)) reduced.push_back(shape_[d]);
     }
-    return result;
+    if (reduced.empty()) reduced.push_back(1);
+    return current.reshape(reduced);
 }
 
-Tensor Tensor::max(size_t axis) const {
+Tensor Tensor::argReduce(bool max, size_t axis, bool keepdims) const {
     if (axis >= rank()) throw std::out_of_range("Axis out of range");
 
-    Shape newShape;
-    for (size_t i = 0; i < rank(); ++i) {
-        if (i != axis) newShape.push_back(shape_[i]);
-    }
-    if (newShape.empty()) newShape.push_back(1);
+    size_t outer = 1, inner = 1;
+    for (size_t d = 0; d < axis; ++d) outer *= shape_[d];
+    for (size_t d = axis + 1; d < rank(); ++d) inner *= shape_[d];
 
-    Tensor result = Tensor::fill(newShape, std::numeric_limits<DataType>::lowest());
-    for (size_t i = 0; i < data_.size(); ++i) {
-        auto idx = unflatIndex(i);
-        std::vector<size_t> newIdx;
-        for (size_t j = 0; j < idx.size(); ++j) {
-            if (j != axis) newIdx.push_back(idx[j]);
-        }
-        if (newIdx.empty()) newIdx.push_back(0);
-        result.at(newIdx) = std::max(result.at(newIdx), data_[i]);
+    const Tensor src = contiguousFloat();
+    std::vector<size_t> idx(outer * inner);
+    reduce::argAxis(max, src.base(), idx.data(), outer, shape_[axis], inner);
+
+    Shape resultShape = shape_;
+    if (keepdims) {
+        resultShape[axis] = 1;
+    } else {
+        resultShape.erase(resultShape.begin() + axis);
+        if (resultShape.empty()) resultShape.push_back(1);
     }
+    Tensor result = uninitialized(resultShape);
+    std::transform(idx.begin(), idx.end(), result.base(),
+                   [](size_t i) { return static_cast<DataType>(i); });
     return result;
 }
 
 // === Matrixoperationen ===
 
 Tensor Tensor::matmul(const Tensor& other) const {
-    if (rank() != 2 || other.rank() != 2) {
-        throw std::invalid_argument("matmul requires 2D tensors");
+    if (rank() == 0 || other.rank() == 0) {
+        throw std::invalid_argument("matmul requires at least 1D tensors");
     }
-    if (shape_[1] != other.shape_[0]) {
-        throw std::invalid_argument("Incompatible shapes for matmul");
+
+    // Vektoren wie in NumPy als Zeile bzw. Spalte; die Achse fällt danach weg
+    if (rank() == 1 && other.rank() == 1) return dot(other);
+    if (rank() == 1) {
+        Tensor result = unsqueeze(0).matmul(other);
+        Shape shape = result.shape_;
+        shape.erase(shape.end() - 2);
+        return result.reshape(shape.empty() ? Shape{1} : shape);
+    }
+    if (other.rank() == 1) {
+        Tensor result = matmul(other.unsqueeze(1));
+        Shape shape = result.shape_;
+        shape.pop_back();
+        return result.reshape(shape.empty() ? Shape{1} : shape);
     }
 
-    size_t m = shape_[0];
-    size_t n = shape_[1];
-    size_t p = other.shape_[1];
+    size_t m = shape_[rank() - 2];
+    size_t k = shape_[rank() - 1];
+    size_t n = other.shape_[other.rank() - 1];
+    if (other.shape_[other.rank() - 2] != k) {
+        throw std::invalid_argument("Incompatible shapes for matmul: " + shapeString() +
+                                    " and " + other.shapeString());
+    }
 
-    Tensor result({m, p});
-    for (size_t i = 0; i < m; ++i) {
-        for (size_t j = 0; j < p; ++j) {
-            DataType sum = 0;
-            for (size_t k = 0; k < n; ++k) {
-                sum += at(i, k) * other.at(k, j);
-            }
-            result.at(i, j) = sum;
-        }
+    if (dtype() != DType::Float32 || other.dtype() != DType::Float32) {
+        return to(DType::Float32).matmul(other.to(DType::Float32))
+            .to(promoteTypes(dtype(), other.dtype()));
     }
+
+    // Gemeinsame Matrix rechts: Batch-Achsen in die Zeilen falten, eine GEMM
+    if (rank() > 2 && other.rank() == 2) {
+        Shape shape = shape_;
+        shape.back() = n;
+        return reshape({size_ / k, k}).matmul(other).reshape(shape);
+    }
+
+    Shape batchA(shape_.begin(), shape_.end() - 2);
+    Shape batchB(other.shape_.begin(), other.shape_.end() - 2);
+    Shape batch = broadcastShapes(batchA, batchB);
+
+    // Gebroadcastete Batch-Achsen erhalten Stride 0, kopiert wird nichts
+    Shape shapeA = batch, shapeB = batch, resultShape = batch;
+    shapeA.push_back(m);
+    shapeA.push_back(k);
+    shapeB.push_back(k);
+    shapeB.push_back(n);
+    resultShape.push_back(m);
+    resultShape.push_back(n);
+    const Tensor a = expand(shapeA);
+    const Tensor b = other.expand(shapeB);
+
+    size_t count = 1;
+    for (size_t d : batch) count *= d;
+    std::vector<size_t> offsetsA(count), offsetsB(count);
+    NdIterator<2> it(batch, {a.strides_, b.strides_});
+    for (size_t i = 0; i < count; ++i, it.next()) {
+        offsetsA[i] = it.offset(0);
+        offsetsB[i] = it.offset(1);
+    }
+
+    // Strides direkt übergeben: transponierte Views brauchen keine Kopie
+    size_t r = batch.size();
+    Tensor result = uninitialized(resultShape);
+    gemm::sgemmBatched(count, m, n, k,
+                       a.base(), offsetsA.data(), a.strides_[r], a.strides_[r + 1],
+                       b.base(), offsetsB.data(), b.strides_[r], b.strides_[r + 1],
+                       result.base(), n, m * n);
     return result;
 }
 
@@ -491,19 +822,31 @@ Tensor Tensor::dot(const Tensor& other) const {
     if (shape_[0] != other.shape_[0]) {
         throw std::invalid_argument("Vectors must have same length");
     }
+    if (dtype() != DType::Float32 || other.dtype() != DType::Float32) {
+        return to(DType::Float32).dot(other.to(DType::Float32))
+            .to(promoteTypes(dtype(), other.dtype()));
+    }
 
+    const DataType* x = base();
+    const DataType* y = other.base();
+    size_t sx = strides_[0];
+    size_t sy = other.strides_[0];
     DataType result = 0;
     for (size_t i = 0; i < shape_[0]; ++i) {
-        result += data_[i] * other[i];
+        result += x[i * sx] * y[i * sy];
     }
     return Tensor(result);
 }
 
 Tensor::DataType Tensor::norm() const {
-    DataType sumSq = 0;
-    for (DataType x : data_) {
-        sumSq += x * x;
-    }
+    if (!storage_ || size_ == 0) return DataType(0);
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    DataType sumSq = parallel_reduce(size_t(0), size_, 0, DataType(0),
+        [in](size_t begin, size_t end) {
+            return reduce::sumSquares(in + begin, end - begin);
+        },
+        std::plus<DataType>());
     return std::sqrt(sumSq);
 }
 
@@ -516,7 +859,11 @@ Tensor Tensor::normalize() const {
 // === Vergleiche ===
 
 bool Tensor::operator==(const Tensor& other) const {
-    return shape_ == other.shape_ && data_ == other.data_;
+    if (shape_ != other.shape_ || size_ != other.size_) return false;
+    if (size_ == 0) return true;
+    const Tensor a = contiguousFloat();
+    const Tensor b = other.contiguousFloat();
+    return std::equal(a.base(), a.base() + size_, b.base());
 }
 
 bool Tensor::operator!=(const Tensor& other) const {
@@ -525,9 +872,13 @@ bool Tensor::operator!=(const Tensor& other) const {
 
 bool Tensor::allClose(const Tensor& other, DataType rtol, DataType atol) const {
     if (shape_ != other.shape_) return false;
-    for (size_t i = 0; i < data_.size(); ++i) {
-        DataType diff = std::abs(data_[i] - other[i]);
-        if (diff > atol + rtol * std::abs(other[i])) {
+    const Tensor ca = contiguousFloat();
+    const Tensor cb = other.contiguousFloat();
+    const DataType* x = ca.data();
+    const DataType* y = cb.data();
+    for (size_t i = 0; i < size_; ++i) {
+        DataType diff = std::abs(x[i] - y[i]);
+        if (diff > atol + rtol * std::abs(y[i])) {
             return false;
         }
     }
@@ -538,16 +889,18 @@ bool Tensor::allClose(const Tensor& other, DataType rtol, DataType atol) const {
 
 std::string Tensor::toString() const {
     if (empty()) return "Tensor([])";
-    if (rank() == 0) return "Tensor(" + std::to_string(data_[0]) + ")";
+    if (rank() == 0) return "Tensor(" + std::to_string(value(0)) + ")";
 
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(4);
 
+    // Views direkt über die Strides lesen, nur andere dtypes umwandeln
+    const Tensor src = dtype() == DType::Float32 ? *this : to(DType::Float32);
     if (rank() == 1) {
         oss << "[";
         for (size_t i = 0; i < shape_[0]; ++i) {
             if (i > 0) oss << ", ";
-            oss << data_[i];
+            oss << src(i);
         }
         oss << "]";
     } else if (rank() == 2) {
@@ -557,7 +910,7 @@ std::string Tensor::toString() const {
             oss << "[";
             for (size_t j = 0; j < shape_[1]; ++j) {
                 if (j > 0) oss << ", ";
-                oss << at(i, j);
+                oss << src(i, j);
             }
             oss << "]";
             if (i < shape_[0] - 1) oss << ",\n";
@@ -566,6 +919,7 @@ std::string Tensor::toString() const {
     } else {
         oss << "Tensor(shape=" << shapeString() << ", data=[...])";
     }
+    if (dtype() != DType::Float32) oss << " " << dtypeName(dtype());
 
     return oss.str();
 }
@@ -576,10 +930,16 @@ std::string Tensor::toDetailedString() const {
     oss << "  shape: " << shapeString() << "\n";
     oss << "  rank: " << rank() << "\n";
     oss << "  size: " << size() << " elements\n";
+    oss << "  dtype: " << dtypeName(dtype()) << " (" << nbytes() << " bytes)\n";
     if (!empty()) {
-        oss << "  min: " << min() << "\n";
-        oss << "  max: " << max() << "\n";
-        oss << "  mean: " << mean() << "\n";
+        Stats st = stats();
+        oss << "  min: " << st.min << "\n";
+        oss << "  max: " << st.max << "\n";
+        oss << "  mean: " << st.mean << "\n";
+        oss << "  std: " << std::sqrt(st.variance) << "\n";
+        if (st.nanCount || st.infCount) {
+            oss << "  nan: " << st.nanCount << ", inf: " << st.infCount << "\n";
+        }
     }
     oss << "  data: " << toString() << "\n";
     oss << "}";
@@ -587,38 +947,40 @@ std::string Tensor::toDetailedString() const {
 }
 
 std::string Tensor::shapeString() const {
-    std::ostringstream oss;
-    oss << "(";
-    for (size_t i = 0; i < shape_.size(); ++i) {
-        if (i > 0) oss << ", ";
-        oss << shape_[i];
-    }
-    oss << ")";
-    return oss.str();
+    return formatShape(shape_);
 }
 
 // === Visualisierungs-Hilfsmethoden ===
 
 std::vector<Tensor::DataType> Tensor::normalizedData() const {
     if (empty()) return {};
-    DataType minVal = min();
-    DataType maxVal = max();
-    DataType range = maxVal - minVal;
+    Stats st = stats();
+    DataType minVal = st.count ? st.min : 0.0f;
+    DataType range = st.count ? st.max - st.min : 0.0f;
     if (range == 0) range = 1;
-
-    std::vector<DataType> result(data_.size());
-    for (size_t i = 0; i < data_.size(); ++i) {
-        result[i] = (data_[i] - minVal) / range;
-    }
+    const DataType scale = 1.0f / range;
+
+    const Tensor src = contiguousFloat();
+    const DataType* in = src.base();
+    std::vector<DataType> result(size_);
+    DataType* out = result.data();
+    parallel_for(0, size_, 0, [=](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Min/Max nur über endliche Werte: Inf auf den Rand klemmen
+            DataType v = (in[i] - minVal) * scale;
+            out[i] = v != v ? 0.0f : std::min(1.0f, std::max(0.0f, v));
+        }
+    });
     return result;
 }
 
 std::vector<Tensor::Point3D> Tensor::get3DPositions(float spacing) const {
     std::vector<Point3D> positions;
-    positions.reserve(data_.size());
+    if (empty()) return positions;
+    positions.reserve(size_);
 
-    for (size_t i = 0; i < data_.size(); ++i) {
-        auto idx = unflatIndex(i);
+    for (NdIterator<> it(shape_); !it.done(); it.next()) {
+        const Shape& idx = it.index();
         Point3D p{0, 0, 0};
         if (idx.size() >= 1) p.x = idx[0] * spacing;
         if (idx.size() >= 2) p.y = idx[1] * spacing;
@@ -633,6 +995,7 @@ std::vector<Tensor::Point3D> Tensor::get3DPositions(float spacing) const {
 
 void Tensor::computeStrides() {
     strides_.resize(shape_.size());
+    contiguous_ = true;
     if (shape_.empty()) return;
 
     strides_.back() = 1;
@@ -641,7 +1004,7 @@ void Tensor::computeStrides() {
     }
 }
 
-size_t Tensor::flatIndex(const std::vector<size_t>& indices) const {
+size_t Tensor::flatIndex(const Shape& indices) const {
     size_t idx = 0;
     for (size_t i = 0; i < indices.size(); ++i) {
         idx += indices[i] * strides_[i];
@@ -649,24 +1012,81 @@ size_t Tensor::flatIndex(const std::vector<size_t>& indices) const {
     return idx;
 }
 
-std::vector<size_t> Tensor::unflatIndex(size_t flatIdx) const {
-    std::vector<size_t> indices(shape_.size());
-    for (size_t i = 0; i < shape_.size(); ++i) {
-        indices[i] = flatIdx / strides_[i];
-        flatIdx %= strides_[i];
+void Tensor::updateContiguous() {
+    size_t expected = 1;
+    contiguous_ = true;
+    for (size_t i = shape_.size(); i-- > 0;) {
+        if (shape_[i] == 1) continue;
+        if (strides_[i] != expected) {
+            contiguous_ = false;
+            return;
+        }
+        expected *= shape_[i];
     }
-    return indices;
+}
+
+void Tensor::reserveVersions(uint64_t& next, uint64_t& end) {
+    static std::atomic<uint64_t> counter{1};
+    constexpr uint64_t BLOCK = 1 << 16;
+    next = counter.fetch_add(BLOCK, std::memory_order_relaxed);
+    end = next + BLOCK;
+}
+
+void Tensor::detach() {
+    markModified();
+    if (!storage_) return;
+    if (ownsStorage()) return;
+
+    auto fresh = std::make_shared<Storage>(size_, dtype());
+    copyTo(fresh->raw());
+    storage_ = std::move(fresh);
+    offset_ = 0;
+    computeStrides();
+}
+
+void Tensor::copyTo(void* dst) const {
+    if (size_ == 0) return;
+    permute::copy(rawBase(), shape_, strides_, dst, itemSize());
+}
+
+Tensor Tensor::contiguousFloat() const {
+    return dtype() == DType::Float32 ? contiguous() : to(DType::Float32);
+}
+
+void Tensor::requireFloat() const {
+    if (dtype() != DType::Float32) {
+        throw std::invalid_argument(std::string("Element references need float32, tensor is ") +
+                                    dtypeName(dtype()) + "; use value() or to()");
+    }
+}
+
+size_t Tensor::storageIndex(size_t index) const {
+    if (contiguous_) return index;
+
+    // Logischen Index über die Strides der View auflösen
+    size_t pos = 0;
+    for (size_t d = shape_.size(); d-- > 0;) {
+        pos += (index % shape_[d]) * strides_[d];
+        index /= shape_[d];
+    }
+    return pos;
 }
 
 void Tensor::validateShape(const Shape& shape) const {
+    // Elementzahl ohne Überlauf: Shapes können aus Dateiköpfen stammen
+    size_t elements = 1;
     for (size_t d : shape) {
         if (d == 0) {
             throw std::invalid_argument("Shape dimensions must be positive");
         }
+        if (elements > std::numeric_limits<size_t>::max() / d) {
+            throw std::invalid_argument("Shape " + formatShape(shape) + " has too many elements");
+        }
+        elements *= d;
     }
 }
 
-void Tensor::validateIndices(const std::vector<size_t>& indices) const {
+void Tensor::validateIndices(const Shape& indices) const {
     if (indices.size() != shape_.size()) {
         throw std::invalid_argument("Number of indices doesn't match rank");
     }
@@ -677,14 +1097,6 @@ void Tensor::validateIndices(const std::vector<size_t>& indices) const {
     }
 }
 
-void Tensor::broadcastShapes(const Tensor& other, Shape& resultShape) const {
-    // Simplified broadcasting - shapes must match for now
-    if (shape_ != other.shape_) {
-        throw std::invalid_argument("Shape mismatch (broadcasting not fully implemented)");
-    }
-    resultShape = shape_;
-}
-
 // === Freie Funktionen ===
 
 Tensor matmul(const Tensor& a, const Tensor& b) {
@@ -695,9 +1107,13 @@ Tensor concatenate(const std::vector<Tensor>& tensors, size_t axis) {
     if (tensors.empty()) {
         throw std::invalid_argument("Cannot concatenate empty list");
     }
+    if (axis >= tensors[0].rank()) {
+        throw std::out_of_range("Axis out of range for concatenate");
+    }
 
-    // Berechne neue Form
+    // Berechne neue Form und gemeinsamen Elementtyp
     Tensor::Shape newShape = tensors[0].shape();
+    DType dtype = tensors[0].dtype();
     for (size_t i = 1; i < tensors.size(); ++i) {
         if (tensors[i].rank() != tensors[0].rank()) {
             throw std::invalid_argument("All tensors must have same rank");
@@ -709,20 +1125,55 @@ Tensor concatenate(const std::vector<Tensor>& tensors, size_t axis) {
                 throw std::invalid_argument("Shape mismatch on non-concat axis");
             }
         }
+        dtype = promoteTypes(dtype, tensors[i].dtype());
     }
 
-    Tensor result(newShape);
-    size_t offset = 0;
-    for (const auto& t : tensors) {
-        for (size_t i = 0; i < t.size(); ++i) {
-            auto idx = result.shape(); // just for sizing
-            // Simple copy for axis 0
-            if (axis == 0) {
-                result[offset + i] = t[i];
+    // Zusammenhängende Quellen im Zieltyp; passende werden nur geteilt
+    size_t n = tensors.size();
+    size_t item = dtypeSize(dtype);
+    size_t innerTail = 1;
+    for (size_t d = axis + 1; d < newShape.size(); ++d) innerTail *= newShape[d];
+
+    std::vector<Tensor> parts;
+    std::vector<const char*> src(n);
+    std::vector<size_t> blockBytes(n), blockStart(n);
+    parts.reserve(n);
+    size_t rowBytes = 0;
+    for (size_t i = 0; i < n; ++i) {
+        parts.push_back(tensors[i].to(dtype).contiguous());
+        src[i] = parts[i].rawBase();
+        blockBytes[i] = parts[i].shape()[axis] * innerTail * item;
+        blockStart[i] = rowBytes;
+        rowBytes += blockBytes[i];
+    }
+
+    // Je Index der Achsen vor axis liegen die Blöcke aller Eingaben
+    // hintereinander im Ergebnis. Aufgeteilt wird nach Ziel-Bytes, damit
+    // viele kleine wie wenige große Eingaben gleich gut parallel laufen.
+    Tensor result = Tensor::uninitialized(newShape, dtype);
+    char* out = result.rawBase();
+    size_t total = result.size() * item;
+    size_t grain = Scheduler::instance().serialThreshold() * sizeof(Tensor::DataType);
+    parallel_for(0, total, grain, [&](size_t begin, size_t end) {
+        size_t o = begin / rowBytes;
+        size_t col = begin % rowBytes;
+        size_t t = static_cast<size_t>(
+            std::upper_bound(blockStart.begin(), blockStart.end(), col) - blockStart.begin()) - 1;
+        size_t within = col - blockStart[t];
+        for (size_t pos = begin; pos < end;) {
+            size_t len = std::min(blockBytes[t] - within, end - pos);
+            std::memcpy(out + pos, src[t] + o * blockBytes[t] + within, len);
+            pos += len;
+            within += len;
+            if (within == blockBytes[t]) {
+                within = 0;
+                if (++t == n) {
+                    t = 0;
+                    ++o;
+                }
             }
         }
-        offset += t.size();
-    }
+    });
 
     return result;
 }
@@ -732,18 +1183,18 @@ Tensor stack(const std::vector<Tensor>& tensors, size_t axis) {
         throw std::invalid_argument("Cannot stack empty list");
     }
 
-    Tensor::Shape newShape = tensors[0].shape();
-    newShape.insert(newShape.begin() + axis, tensors.size());
-
-    Tensor result(newShape);
-    for (size_t i = 0; i < tensors.size(); ++i) {
-        for (size_t j = 0; j < tensors[i].size(); ++j) {
-            // Vereinfachte Implementierung
-            result[i * tensors[i].size() + j] = tensors[i][j];
+    // Jede Eingabe bekommt eine neue Achse der Größe 1 (View), dann
+    // wie concatenate entlang dieser Achse
+    std::vector<Tensor> views;
+    views.reserve(tensors.size());
+    for (const auto& t : tensors) {
+        if (t.shape() != tensors[0].shape()) {
+            throw std::invalid_argument("All tensors must have same shape");
         }
+        views.push_back(t.unsqueeze(axis));
     }
 
-    return result;
+    return concatenate(views, axis);
 }
 
 } // namespace tensor
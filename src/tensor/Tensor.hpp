@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
@@ -9,9 +10,23 @@
 #include <numeric>
 #include <sstream>
 #include <iomanip>
+#include "tensor/Shape.hpp"
+#include "tensor/Storage.hpp"
 
 namespace tensor {
 
+namespace expr {
+template <typename Derived> class Expr;
+class Leaf;
+}
+
+namespace reduce {
+enum class Op;
+struct Stats;
+}
+
+template <typename T, size_t... Dims> class StaticTensor;
+
 /**
  * @brief Multidimensionale Tensor-Klasse
  *
@@ -22,10 +37,21 @@ namespace tensor {
  * - Rang 1: Vektor (1D Array)
  * - Rang 2: Matrix (2D Array)
  * - Rang 3+: Höherdimensionaler Tensor
+ *
+ * Die Daten liegen in einem geteilten Storage. Ein Tensor beschreibt
+ * darauf eine Sicht aus Shape, Strides und Offset. slice(), transpose(),
+ * reshape() & Co. ändern nur diese Metadaten; kopiert wird erst, wenn
+ * zusammenhängende Daten gebraucht werden oder in einen geteilten
+ * Storage geschrieben wird (Copy-on-Write).
+ *
+ * Gespeichert wird standardmäßig float32, mit to() auch kompakter (siehe
+ * DType). Gerechnet wird immer in float32; Referenzen auf Elemente
+ * (operator[], at(), data()) gibt es daher nur für float32-Tensoren.
  */
 class Tensor {
 public:
-    using Shape = std::vector<size_t>;
+    using Shape = tensor::Shape;
+    using Strides = tensor::Shape;
     using DataType = float;
 
     // === Konstruktoren ===
@@ -53,37 +79,73 @@ public:
 
     // === Fabrikmethoden ===
 
-    static Tensor zeros(const Shape& shape);
-    static Tensor ones(const Shape& shape);
-    static Tensor fill(const Shape& shape, DataType value);
+    static Tensor zeros(const Shape& shape, DType dtype = DType::Float32);
+    static Tensor ones(const Shape& shape, DType dtype = DType::Float32);
+    static Tensor fill(const Shape& shape, DataType value, DType dtype = DType::Float32);
+    // Zufallswerte aus Generator::global() (Philox, parallel; manualSeed()
+    // macht sie reproduzierbar): gleichverteilt in [min, max) bzw. normalverteilt
     static Tensor random(const Shape& shape, DataType min = 0.0f, DataType max = 1.0f);
+    static Tensor randn(const Shape& shape, DataType mean = 0.0f, DataType stddev = 1.0f);
     static Tensor range(DataType start, DataType end, DataType step = 1.0f);
     static Tensor identity(size_t n);
     static Tensor fromVector(const std::vector<DataType>& vec);
     static Tensor fromMatrix(const std::vector<std::vector<DataType>>& mat);
 
+    // Tensor aus zusammenhängenden Rohdaten vom Typ dtype (z.B. aus Dateien)
+    static Tensor fromBytes(const Shape& shape, DType dtype, const void* bytes);
+
+    // Tensor aus func(flacher Index); wie apply() parallel und inline
+    template <typename F>
+    static Tensor generate(const Shape& shape, F func);
+
     // === Eigenschaften ===
 
     const Shape& shape() const { return shape_; }
     size_t rank() const { return shape_.size(); }
-    size_t size() const { return data_.size(); }
-    bool empty() const { return data_.empty(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Elementtyp des Speichers und belegte Bytes der Elemente
+    DType dtype() const { return storage_ ? storage_->dtype() : DType::Float32; }
+    size_t itemSize() const { return dtypeSize(dtype()); }
+    size_t nbytes() const { return size_ * itemSize(); }
 
     // Dimensionsgröße
     size_t dim(size_t axis) const;
 
-    // Strides für Indexberechnung
-    const std::vector<size_t>& strides() const { return strides_; }
+    // Strides (in Elementen) für Indexberechnung; bei Views nicht zwingend zeilenweise
+    const Strides& strides() const { return strides_; }
+
+    // Startposition im Storage
+    size_t offset() const { return offset_; }
+
+    // Liegen die Elemente zeilenweise ohne Lücken im Speicher?
+    bool isContiguous() const { return contiguous_; }
+
+    // Teilen sich beide Tensoren denselben Storage?
+    bool sharesStorage(const Tensor& other) const;
+
+    // Liegen die Daten in einer gemappten Datei (siehe MappedFile)?
+    bool isMapped() const { return storage_ && storage_->external(); }
+
+    // Zusammenhängende Version: teilt den Storage, falls möglich, sonst Kopie
+    Tensor contiguous() const;
+
+    // Umgewandelte, zusammenhängende Kopie; bei gleichem Typ *this
+    Tensor to(DType dtype) const;
 
     // === Datenzugriff ===
 
-    // Linearer Zugriff
+    // Wert an logischem Index, für jeden dtype
+    DataType value(size_t index) const;
+
+    // Linearer Zugriff (logische, zeilenweise Reihenfolge); nur float32
     DataType& operator[](size_t index);
     const DataType& operator[](size_t index) const;
 
-    // Multidimensionaler Zugriff
-    DataType& at(const std::vector<size_t>& indices);
-    const DataType& at(const std::vector<size_t>& indices) const;
+    // Multidimensionaler Zugriff, immer geprüft
+    DataType& at(const Shape& indices);
+    const DataType& at(const Shape& indices) const;
 
     // Für 2D (Matrix)
     DataType& at(size_t row, size_t col);
@@ -93,9 +155,48 @@ public:
     DataType& at(size_t i, size_t j, size_t k);
     const DataType& at(size_t i, size_t j, size_t k) const;
 
-    // Rohdaten
-    std::vector<DataType>& data() { return data_; }
-    const std::vector<DataType>& data() const { return data_; }
+    // Zugriff für Schleifen: nur Multiplikation und Addition über die
+    // Strides, auch bei Views. Rang und Grenzen werden nur mit
+    // TENSOR_BOUNDS_CHECK geprüft (nicht im Release-Build); nur float32
+    const DataType& operator()(size_t i) const {
+        checkAccess({i});
+        return base()[i * strides_[0]];
+    }
+    const DataType& operator()(size_t i, size_t j) const {
+        checkAccess({i, j});
+        return base()[i * strides_[0] + j * strides_[1]];
+    }
+    const DataType& operator()(size_t i, size_t j, size_t k) const {
+        checkAccess({i, j, k});
+        return base()[i * strides_[0] + j * strides_[1] + k * strides_[2]];
+    }
+    DataType& operator()(size_t i) {
+        prepareWrite();
+        return const_cast<DataType&>(static_cast<const Tensor&>(*this)(i));
+    }
+    DataType& operator()(size_t i, size_t j) {
+        prepareWrite();
+        return const_cast<DataType&>(static_cast<const Tensor&>(*this)(i, j));
+    }
+    DataType& operator()(size_t i, size_t j, size_t k) {
+        prepareWrite();
+        return const_cast<DataType&>(static_cast<const Tensor&>(*this)(i, j, k));
+    }
+
+    // Elemente in zeilenweiser Reihenfolge als Bytes des eigenen dtype
+    // nach dst kopieren (nbytes() Bytes, auch für Views)
+    void copyBytes(void* dst) const;
+
+    // Rohdaten: schreibend immer exklusiv und zusammenhängend,
+    // lesend nur bei isContiguous() linear zu interpretieren
+    DataType* data();
+    const DataType* data() const;
+
+    // Änderungszähler: jeder schreibende Zugriff (nicht-const data(),
+    // operator[], at(), operator(), +=, ...) vergibt eine neue, global
+    // eindeutige Nummer. Gleiche Nummer heißt gleicher Inhalt. Schreiben
+    // über einen vorher geholten data()-Zeiger zählt zum Zeitpunkt des Holens.
+    uint64_t version() const { return version_; }
 
     // === Umformung ===
 
@@ -106,6 +207,14 @@ public:
     Tensor squeeze() const;  // Entfernt Dimensionen der Größe 1
     Tensor unsqueeze(size_t axis) const;  // Fügt Dimension hinzu
 
+    // Broadcast-View auf shape: Achsen der Größe 1 und fehlende führende
+    // Achsen erhalten Stride 0, es wird nichts kopiert
+    Tensor expand(const Shape& shape) const;
+
+    // Ergebnis-Shape nach NumPy-Regeln: rechtsbündig vergleichen,
+    // Größe 1 passt zu jeder Größe; wirft bei inkompatiblen Shapes
+    static Shape broadcastShapes(const Shape& a, const Shape& b);
+
     // === Slicing ===
 
     Tensor slice(size_t axis, size_t start, size_t end) const;
@@ -114,50 +223,118 @@ public:
 
     // === Elementweise Operationen ===
 
-    Tensor operator+(const Tensor& other) const;
-    Tensor operator-(const Tensor& other) const;
-    Tensor operator*(const Tensor& other) const;  // Elementweise!
-    Tensor operator/(const Tensor& other) const;
-
-    Tensor operator+(DataType scalar) const;
-    Tensor operator-(DataType scalar) const;
-    Tensor operator*(DataType scalar) const;
-    Tensor operator/(DataType scalar) const;
-
+    // +, -, * und / (auch mit Skalaren) sind freie Operatoren in TensorExpr.hpp.
+    // Sie liefern lazy Ausdrücke, die erst bei der Zuweisung an einen Tensor
+    // in einer einzigen Schleife ausgewertet werden. Unterschiedliche Shapes
+    // werden per Broadcasting (Stride 0) angeglichen, ohne Kopie. Temporäre Tensoren im
+    // Ausdruck (z.B. a.matmul(b) + c) geben dabei ihren Puffer für das
+    // Ergebnis her.
+    template <typename E>
+    Tensor(const expr::Expr<E>& e);
+    template <typename E>
+    Tensor(expr::Expr<E>&& e);
+    template <typename E>
+    Tensor& operator=(const expr::Expr<E>& e);
+    template <typename E>
+    Tensor& operator=(expr::Expr<E>&& e);
+
+    // In-place: schreibt direkt in den eigenen Puffer (kopiert nur, wenn
+    // der Storage geteilt ist), z.B. W -= lr * dW ohne Allokation.
+    // Die rechte Seite darf auf die eigene Shape broadcasten.
     Tensor& operator+=(const Tensor& other);
     Tensor& operator-=(const Tensor& other);
     Tensor& operator*=(const Tensor& other);
     Tensor& operator/=(const Tensor& other);
 
-    Tensor operator-() const;  // Negation
-
-    // Elementweise Funktionen
-    Tensor apply(std::function<DataType(DataType)> func) const;
-    Tensor sqrt() const;
-    Tensor pow(DataType exponent) const;
-    Tensor exp() const;
-    Tensor log() const;
-    Tensor abs() const;
-    Tensor sin() const;
-    Tensor cos() const;
+    template <typename E> Tensor& operator+=(const expr::Expr<E>& e);
+    template <typename E> Tensor& operator-=(const expr::Expr<E>& e);
+    template <typename E> Tensor& operator*=(const expr::Expr<E>& e);
+    template <typename E> Tensor& operator/=(const expr::Expr<E>& e);
+
+    Tensor& operator+=(DataType scalar);
+    Tensor& operator-=(DataType scalar);
+    Tensor& operator*=(DataType scalar);
+    Tensor& operator/=(DataType scalar);
+
+    auto operator-() const;  // Negation
+
+    // Elementweise Funktion; func wird inline aufgerufen, bei großen
+    // Tensoren parallel, und muss daher threadsicher sein
+    template <typename F>
+    Tensor apply(F func) const;
+
+    // Elementweise Funktionen (lazy, verkettbar, vektorisiert)
+    auto sqrt() const;
+    auto pow(DataType exponent) const;
+    auto exp() const;
+    auto log() const;
+    auto abs() const;
+    auto sin() const;
+    auto cos() const;
+
+    // Aktivierungen, ebenfalls lazy: (x.matmul(W) + b).relu() in einem Durchlauf
+    auto relu() const;
+    auto sigmoid() const;
+    auto tanh() const;
+    auto gelu() const;  // Tanh-Näherung
 
     // === Reduktionen ===
 
+    // Ergebnisse sind immer float32, unabhängig vom dtype
+
     DataType sum() const;
     DataType mean() const;
     DataType min() const;
     DataType max() const;
     DataType prod() const;
-
-    // Achsenweise Reduktionen
-    Tensor sum(size_t axis) const;
-    Tensor mean(size_t axis) const;
-    Tensor min(size_t axis) const;
-    Tensor max(size_t axis) const;
+    DataType var() const;     // Varianz (Division durch N)
+    DataType stddev() const;  // Standardabweichung
+
+    // Kennzahlen in einem parallelen Durchlauf; min/max/sum/mean/variance
+    // über die endlichen Werte (ohne endliche Werte: NaN), NaN/Inf gezählt.
+    // Zwischengespeichert bis zur nächsten Änderung (siehe version()):
+    // wiederholte Abfragen - auch min()/max()/mean() - kosten dann O(1)
+    struct Stats {
+        DataType min = 0, max = 0, sum = 0, mean = 0, variance = 0;
+        size_t count = 0;  // endliche Werte
+        size_t nanCount = 0;
+        size_t infCount = 0;
+    };
+    Stats stats() const;
+
+    // Flacher Index des ersten Minimums/Maximums
+    size_t argmin() const;
+    size_t argmax() const;
+
+    // Achsenweise Reduktionen; keepdims behält die Achse mit Größe 1
+    // (für Broadcasting gegen das Original, z.B. x - x.mean(1, true))
+    Tensor sum(size_t axis, bool keepdims = false) const;
+    Tensor mean(size_t axis, bool keepdims = false) const;
+    Tensor min(size_t axis, bool keepdims = false) const;
+    Tensor max(size_t axis, bool keepdims = false) const;
+    Tensor var(size_t axis, bool keepdims = false) const;
+    Tensor stddev(size_t axis, bool keepdims = false) const;
+
+    // Über mehrere Achsen gleichzeitig
+    Tensor sum(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Tensor mean(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Tensor min(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Tensor max(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Tensor var(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Tensor stddev(const std::vector<size_t>& axes, bool keepdims = false) const;
+
+    // Position des Minimums/Maximums entlang axis (als Werte gespeichert)
+    Tensor argmin(size_t axis, bool keepdims = false) const;
+    Tensor argmax(size_t axis, bool keepdims = false) const;
 
     // === Matrixoperationen ===
 
-    Tensor matmul(const Tensor& other) const;  // Matrixmultiplikation
+    // Ergebnis im gemeinsamen Typ beider Operanden (promoteTypes)
+
+    // Matrixmultiplikation über die letzten beiden Achsen; davor liegende
+    // Batch-Achsen werden gebroadcastet, z.B. (B, M, K) @ (K, N) oder
+    // (B, 1, M, K) @ (H, K, N). 1D-Operanden zählen als Zeile bzw. Spalte.
+    Tensor matmul(const Tensor& other) const;
     Tensor dot(const Tensor& other) const;     // Skalarprodukt für Vektoren
     DataType norm() const;                      // Euklidische Norm
     Tensor normalize() const;                   // Normalisieren
@@ -176,7 +353,7 @@ public:
 
     // === Hilfsmethoden für Visualisierung ===
 
-    // Gibt Werte in normalisierten Bereich [0,1] zurück
+    // Gibt Werte in normalisierten Bereich [0,1] zurück (NaN -> 0, ±Inf -> 0/1)
     std::vector<DataType> normalizedData() const;
 
     // Für 3D-Visualisierung: Position im Raum für jeden Index
@@ -184,21 +361,111 @@ public:
     std::vector<Point3D> get3DPositions(float spacing = 1.0f) const;
 
 private:
+    friend class expr::Leaf;
+    friend Tensor concatenate(const std::vector<Tensor>& tensors, size_t axis);
+    friend class Generator;
+    friend class MappedFile;
+    friend class Stream;
+    template <typename T, size_t... Dims> friend class StaticTensor;
+
     Shape shape_;
-    std::vector<size_t> strides_;
-    std::vector<DataType> data_;
+    Strides strides_;
+    std::shared_ptr<Storage> storage_;
+    size_t offset_ = 0;
+    size_t size_ = 0;
+    bool contiguous_ = true;
+
+    // Siehe version(); Cache von stats() mit der Version, für die er gilt
+    struct StatsCache {
+        uint64_t version;
+        Stats stats;
+    };
+    uint64_t version_ = nextVersion();
+    mutable std::shared_ptr<const StatsCache> statsCache_;
+
+    // Nummern kommen blockweise pro Thread: eindeutig ohne Atomic je Schreibzugriff
+    static uint64_t nextVersion() {
+        thread_local uint64_t next = 0, end = 0;
+        if (next == end) reserveVersions(next, end);
+        return next++;
+    }
+    static void reserveVersions(uint64_t& next, uint64_t& end);
+    void markModified() { version_ = nextVersion(); }
+    Stats computeStats() const;
+    static Stats makeStats(const reduce::Stats& r);
+
+    // Sicht auf vorhandenen Storage
+    Tensor(std::shared_ptr<Storage> storage, const Shape& shape,
+           const Strides& strides, size_t offset);
+
+    // Neuer Tensor ohne Initialisierung der Daten
+    static Tensor uninitialized(const Shape& shape, DType dtype = DType::Float32);
+
+    // Reduktion über sortierte, eindeutige Achsen
+    Tensor reduceAxes(reduce::Op op, const std::vector<size_t>& axes, bool keepdims) const;
+    Tensor argReduce(bool max, size_t axis, bool keepdims) const;
+
+    // this = this op e, elementweise im eigenen Puffer
+    template <typename Op, typename E>
+    Tensor& compoundAssign(E e);
+
+    // Nur für float32-Storage
+    DataType* base() { return storage_->data() + offset_; }
+    const DataType* base() const { return storage_->data() + offset_; }
+
+    // Erstes Element als Bytes, für jeden dtype
+    char* rawBase() { return static_cast<char*>(storage_->raw()) + offset_ * itemSize(); }
+    const char* rawBase() const { return static_cast<const char*>(storage_->raw()) + offset_ * itemSize(); }
+
+    // Zusammenhängend in float32, zum Rechnen (ohne Kopie, wenn schon passend)
+    Tensor contiguousFloat() const;
+
+    // Wirft, wenn Elemente nicht als float referenziert werden können
+    void requireFloat() const;
+
+    // Darf in den Storage geschrieben werden, ohne andere Besitzer zu stören?
+    bool ownsStorage(long owners = 1) const {
+        return contiguous_ && storage_.use_count() == owners && storage_->writable();
+    }
+
+    // Vor Schreibzugriffen: exklusiven, zusammenhängenden Storage sicherstellen
+    // (zählt immer als Änderung)
+    void detach();
+    void prepareWrite() {
+        if (!ownsStorage()) {
+            detach();
+        } else {
+            markModified();
+        }
+    }
+
+    void checkAccess(std::initializer_list<size_t> indices) const {
+#if TENSOR_BOUNDS_CHECK
+        validateIndices(Shape(indices));
+        requireFloat();
+#else
+        (void)indices;
+#endif
+    }
+    // Elemente in zeilenweiser Reihenfolge nach dst kopieren (gleicher dtype)
+    void copyTo(void* dst) const;
+    void updateContiguous();
 
     void computeStrides();
-    size_t flatIndex(const std::vector<size_t>& indices) const;
-    std::vector<size_t> unflatIndex(size_t flatIdx) const;
+    size_t flatIndex(const Shape& indices) const;
+    // Position im Storage (relativ zu offset_) für einen logischen Index
+    size_t storageIndex(size_t index) const;
     void validateShape(const Shape& shape) const;
-    void validateIndices(const std::vector<size_t>& indices) const;
-    void broadcastShapes(const Tensor& other, Shape& resultShape) const;
+    void validateIndices(const Shape& indices) const;
 };
 
 // Freie Funktionen für Operationen
 Tensor matmul(const Tensor& a, const Tensor& b);
+// Aneinanderhängen entlang axis bzw. Stapeln entlang einer neuen Achse;
+// Ergebnis im gemeinsamen Typ, kopiert blockweise per memcpy (parallel)
 Tensor concatenate(const std::vector<Tensor>& tensors, size_t axis);
 Tensor stack(const std::vector<Tensor>& tensors, size_t axis = 0);
 
 } // namespace tensor
+
+#include "tensor/TensorExpr.hpp"
@@ -1,10 +1,68 @@
 #include "tensor/TensorDB.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
 
 namespace tensor {
 
+namespace {
+
+// Kennung am Dateianfang; ältere Dateien beginnen direkt mit der Anzahl
+// und enthalten nur float32. Ab Version 3 steht vor jedem Eintrag seine
+// Art (dicht oder sparse).
+constexpr uint64_t FILE_MAGIC_V2 = 0x3242445453524E54ull;  // "TNRSTDB2"
+constexpr uint64_t FILE_MAGIC = 0x3342445453524E54ull;     // "TNRSTDB3"
+
+enum class EntryKind : uint8_t {
+    Dense,
+    Sparse
+};
+
+template <typename T>
+void writeArray(std::ofstream& file, const std::vector<T>& values) {
+    size_t count = values.size();
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(values.data()), count * sizeof(T));
+}
+
+// Bytes bis zum Dateiende; Längen aus der Datei werden daran gemessen,
+// damit eine kaputte Länge keine riesige Allokation auslöst
+size_t remainingBytes(std::ifstream& file) {
+    const std::streampos pos = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streampos end = file.tellg();
+    file.seekg(pos);
+    return file && end >= pos ? static_cast<size_t>(end - pos) : 0;
+}
+
+// Länge lesen; passen so viele Elemente nicht in den Rest der Datei,
+// schlägt der Stream fehl
+size_t readLength(std::ifstream& file, size_t elementSize) {
+    size_t count = 0;
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (file && count > remainingBytes(file) / elementSize) file.setstate(std::ios::failbit);
+    return file ? count : 0;
+}
+
+template <typename T>
+std::vector<T> readArray(std::ifstream& file) {
+    std::vector<T> values(readLength(file, sizeof(T)));
+    file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+    return values;
+}
+
+// Namen aller Einträge (dicht oder sparse), die pred erfüllen
+template <typename Map, typename Pred>
+void collectNames(const Map& entries, Pred pred, std::vector<std::string>& names) {
+    for (const auto& [name, entry] : entries) {
+        if (pred(entry)) names.push_back(name);
+    }
+}
+
+} // namespace
+
 // === TensorMetadata ===
 
 std::string TensorMetadata::shapeString() const {
@@ -43,17 +101,64 @@ void TensorDB::store(const std::string& name, const Tensor& tensor,
     meta.description = description;
     meta.shape = tensor.shape();
     meta.size = tensor.size();
+    meta.dtype = tensor.dtype();
     meta.created = now;
     meta.modified = now;
 
+    sparse_.erase(name);
     tensors_[name] = {tensor, meta};
 }
 
+void TensorDB::storeSparse(const std::string& name, const SparseTensor& tensor,
+                           const std::string& description) {
+    auto now = std::chrono::system_clock::now();
+
+    TensorMetadata meta;
+    meta.name = name;
+    meta.description = description;
+    meta.shape = tensor.shape();
+    meta.size = tensor.rows() * tensor.cols();
+    meta.dtype = DType::Float32;
+    meta.sparse = true;
+    meta.nnz = tensor.nnz();
+    meta.created = now;
+    meta.modified = now;
+
+    tensors_.erase(name);
+    sparse_[name] = {tensor, meta};
+}
+
+std::optional<SparseTensor> TensorDB::getSparse(const std::string& name) const {
+    auto it = sparse_.find(name);
+    if (it != sparse_.end()) {
+        return it->second.tensor;
+    }
+    return std::nullopt;
+}
+
+bool TensorDB::isSparse(const std::string& name) const {
+    return sparse_.find(name) != sparse_.end();
+}
+
+TensorMetadata* TensorDB::findMetadata(const std::string& name) {
+    return const_cast<TensorMetadata*>(static_cast<const TensorDB*>(this)->findMetadata(name));
+}
+
+const TensorMetadata* TensorDB::findMetadata(const std::string& name) const {
+    if (auto it = tensors_.find(name); it != tensors_.end()) return &it->second.metadata;
+    if (auto it = sparse_.find(name); it != sparse_.end()) return &it->second.metadata;
+    return nullptr;
+}
+
 std::optional<Tensor> TensorDB::get(const std::string& name) const {
     auto it = tensors_.find(name);
     if (it != tensors_.end()) {
         return it->second.tensor;
     }
+    auto sparseIt = sparse_.find(name);
+    if (sparseIt != sparse_.end()) {
+        return sparseIt->second.tensor.toDense();
+    }
     return std::nullopt;
 }
 
@@ -76,61 +181,71 @@ const Tensor& TensorDB::getRef(const std::string& name) const {
 bool TensorDB::update(const std::string& name, const Tensor& tensor) {
     auto it = tensors_.find(name);
     if (it == tensors_.end()) {
-        return false;
+        // Ein sparse Eintrag wird dicht; Metadaten und Tags bleiben
+        auto sparseIt = sparse_.find(name);
+        if (sparseIt == sparse_.end()) {
+            return false;
+        }
+        TensorMetadata meta = sparseIt->second.metadata;
+        meta.sparse = false;
+        meta.nnz = 0;
+        sparse_.erase(sparseIt);
+        it = tensors_.emplace(name, TensorEntry{tensor, meta}).first;
     }
 
     it->second.tensor = tensor;
     it->second.metadata.shape = tensor.shape();
     it->second.metadata.size = tensor.size();
+    it->second.metadata.dtype = tensor.dtype();
     it->second.metadata.modified = std::chrono::system_clock::now();
     return true;
 }
 
 bool TensorDB::remove(const std::string& name) {
-    return tensors_.erase(name) > 0;
+    return tensors_.erase(name) + sparse_.erase(name) > 0;
 }
 
 bool TensorDB::exists(const std::string& name) const {
-    return tensors_.find(name) != tensors_.end();
+    return findMetadata(name) != nullptr;
 }
 
 std::vector<std::string> TensorDB::listNames() const {
     std::vector<std::string> names;
-    names.reserve(tensors_.size());
-    for (const auto& [name, _] : tensors_) {
-        names.push_back(name);
-    }
+    names.reserve(count());
+    collectNames(tensors_, [](const auto&) { return true; }, names);
+    collectNames(sparse_, [](const auto&) { return true; }, names);
+    std::sort(names.begin(), names.end());
     return names;
 }
 
 void TensorDB::clear() {
     tensors_.clear();
+    sparse_.clear();
 }
 
 std::optional<TensorMetadata> TensorDB::getMetadata(const std::string& name) const {
-    auto it = tensors_.find(name);
-    if (it != tensors_.end()) {
-        return it->second.metadata;
+    if (const TensorMetadata* meta = findMetadata(name)) {
+        return *meta;
     }
     return std::nullopt;
 }
 
 bool TensorDB::setTag(const std::string& name, const std::string& key, const std::string& value) {
-    auto it = tensors_.find(name);
-    if (it == tensors_.end()) {
+    TensorMetadata* meta = findMetadata(name);
+    if (!meta) {
         return false;
     }
-    it->second.metadata.tags[key] = value;
+    meta->tags[key] = value;
     return true;
 }
 
 std::optional<std::string> TensorDB::getTag(const std::string& name, const std::string& key) const {
-    auto it = tensors_.find(name);
-    if (it == tensors_.end()) {
+    const TensorMetadata* meta = findMetadata(name);
+    if (!meta) {
         return std::nullopt;
     }
-    auto tagIt = it->second.metadata.tags.find(key);
-    if (tagIt != it->second.metadata.tags.end()) {
+    auto tagIt = meta->tags.find(key);
+    if (tagIt != meta->tags.end()) {
         return tagIt->second;
     }
     return std::nullopt;
@@ -138,32 +253,31 @@ std::optional<std::string> TensorDB::getTag(const std::string& name, const std::
 
 std::vector<std::string> TensorDB::findByShape(const Tensor::Shape& shape) const {
     std::vector<std::string> results;
-    for (const auto& [name, entry] : tensors_) {
-        if (entry.tensor.shape() == shape) {
-            results.push_back(name);
-        }
-    }
+    auto matches = [&](const auto& entry) { return entry.tensor.shape() == shape; };
+    collectNames(tensors_, matches, results);
+    collectNames(sparse_, matches, results);
+    std::sort(results.begin(), results.end());
     return results;
 }
 
 std::vector<std::string> TensorDB::findByRank(size_t rank) const {
     std::vector<std::string> results;
-    for (const auto& [name, entry] : tensors_) {
-        if (entry.tensor.rank() == rank) {
-            results.push_back(name);
-        }
-    }
+    auto matches = [&](const auto& entry) { return entry.tensor.shape().size() == rank; };
+    collectNames(tensors_, matches, results);
+    collectNames(sparse_, matches, results);
+    std::sort(results.begin(), results.end());
     return results;
 }
 
 std::vector<std::string> TensorDB::findByTag(const std::string& key, const std::string& value) const {
     std::vector<std::string> results;
-    for (const auto& [name, entry] : tensors_) {
+    auto matches = [&](const auto& entry) {
         auto tagIt = entry.metadata.tags.find(key);
-        if (tagIt != entry.metadata.tags.end() && tagIt->second == value) {
-            results.push_back(name);
-        }
-    }
+        return tagIt != entry.metadata.tags.end() && tagIt->second == value;
+    };
+    collectNames(tensors_, matches, results);
+    collectNames(sparse_, matches, results);
+    std::sort(results.begin(), results.end());
     return results;
 }
 
@@ -200,6 +314,19 @@ bool TensorDB::compute(const std::string& resultName,
     }
 }
 
+std::optional<Tensor> TensorDB::batch(const std::vector<std::string>& names, size_t axis) const {
+    std::vector<Tensor> samples;
+    samples.reserve(names.size());
+    for (const auto& name : names) {
+        auto tensor = get(name);
+        if (!tensor) {
+            return std::nullopt;
+        }
+        samples.push_back(std::move(*tensor));
+    }
+    return stack(samples, axis);
+}
+
 bool TensorDB::apply(const std::string& name, std::function<void(Tensor&)> func) {
     auto it = tensors_.find(name);
     if (it == tensors_.end()) {
@@ -215,20 +342,32 @@ bool TensorDB::saveToFile(const std::string& filename) const {
     std::ofstream file(filename, std::ios::binary);
     if (!file) return false;
 
-    // Einfaches Format: Anzahl, dann für jeden Tensor: Name, Shape, Daten
-    size_t count = tensors_.size();
+    // Einfaches Format: Kennung, Anzahl, dann für jeden Eintrag:
+    // Name, Beschreibung, Art, danach
+    //   dicht:  Shape, dtype, Daten im eigenen Typ
+    //   sparse: Format, Zeilen, Spalten, Blockgröße, Index- und Wertarrays
+    uint64_t magic = FILE_MAGIC;
+    file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    size_t count = this->count();
     file.write(reinterpret_cast<const char*>(&count), sizeof(count));
 
-    for (const auto& [name, entry] : tensors_) {
+    auto writeHeader = [&](const std::string& name, const TensorMetadata& meta, EntryKind kind) {
         // Name
         size_t nameLen = name.size();
         file.write(reinterpret_cast<const char*>(&nameLen), sizeof(nameLen));
         file.write(name.data(), nameLen);
 
         // Description
-        size_t descLen = entry.metadata.description.size();
+        size_t descLen = meta.description.size();
         file.write(reinterpret_cast<const char*>(&descLen), sizeof(descLen));
-        file.write(entry.metadata.description.data(), descLen);
+        file.write(meta.description.data(), descLen);
+
+        uint8_t kindByte = static_cast<uint8_t>(kind);
+        file.write(reinterpret_cast<const char*>(&kindByte), sizeof(kindByte));
+    };
+
+    for (const auto& [name, entry] : tensors_) {
+        writeHeader(name, entry.metadata, EntryKind::Dense);
 
         // Shape
         size_t rank = entry.tensor.rank();
@@ -237,14 +376,33 @@ bool TensorDB::saveToFile(const std::string& filename) const {
             file.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
         }
 
-        // Daten
+        uint8_t dtype = static_cast<uint8_t>(entry.tensor.dtype());
+        file.write(reinterpret_cast<const char*>(&dtype), sizeof(dtype));
+
+        // Daten (auch Views in zeilenweiser Reihenfolge)
         size_t dataSize = entry.tensor.size();
         file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
-        file.write(reinterpret_cast<const char*>(entry.tensor.data().data()),
-                   dataSize * sizeof(Tensor::DataType));
+        std::vector<char> bytes(entry.tensor.nbytes());
+        entry.tensor.copyBytes(bytes.data());
+        file.write(bytes.data(), bytes.size());
     }
 
-    return true;
+    for (const auto& [name, entry] : sparse_) {
+        writeHeader(name, entry.metadata, EntryKind::Sparse);
+
+        const SparseTensor& tensor = entry.tensor;
+        uint8_t format = static_cast<uint8_t>(tensor.format());
+        file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+        size_t dims[3] = {tensor.rows(), tensor.cols(), tensor.blockSize()};
+        file.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+
+        writeArray(file, tensor.rowPtr());
+        writeArray(file, tensor.rowIndices());
+        writeArray(file, tensor.colIndices());
+        writeArray(file, tensor.values());
+    }
+
+    return static_cast<bool>(file);
 }
 
 bool TensorDB::loadFromFile(const std::string& filename) {
@@ -253,38 +411,93 @@ bool TensorDB::loadFromFile(const std::string& filename) {
 
     clear();
 
-    size_t count;
-    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    uint64_t magic;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    bool kinds = magic == FILE_MAGIC;
+    bool typed = kinds || magic == FILE_MAGIC_V2;
+    size_t count = static_cast<size_t>(magic);
+    if (typed) file.read(reinterpret_cast<char*>(&count), sizeof(count));
 
     for (size_t i = 0; i < count; ++i) {
         // Name
-        size_t nameLen;
-        file.read(reinterpret_cast<char*>(&nameLen), sizeof(nameLen));
+        size_t nameLen = readLength(file, 1);
+        if (!file) return false;
         std::string name(nameLen, '\0');
         file.read(name.data(), nameLen);
 
         // Description
-        size_t descLen;
-        file.read(reinterpret_cast<char*>(&descLen), sizeof(descLen));
+        size_t descLen = readLength(file, 1);
+        if (!file) return false;
         std::string description(descLen, '\0');
         file.read(description.data(), descLen);
 
+        uint8_t kind = static_cast<uint8_t>(EntryKind::Dense);
+        if (kinds) file.read(reinterpret_cast<char*>(&kind), sizeof(kind));
+
+        if (kind == static_cast<uint8_t>(EntryKind::Sparse)) {
+            uint8_t format;
+            file.read(reinterpret_cast<char*>(&format), sizeof(format));
+            size_t dims[3];
+            file.read(reinterpret_cast<char*>(dims), sizeof(dims));
+
+            auto rowPtr = readArray<size_t>(file);
+            auto rowIndices = readArray<SparseTensor::Index>(file);
+            auto colIndices = readArray<SparseTensor::Index>(file);
+            auto values = readArray<float>(file);
+            if (!file) return false;
+
+            // Die Fabriken prüfen die Struktur; kaputte Dateien scheitern hier
+            try {
+                switch (static_cast<SparseFormat>(format)) {
+                    case SparseFormat::COO:
+                        storeSparse(name, SparseTensor::fromCOO(dims[0], dims[1], std::move(rowIndices),
+                                                                std::move(colIndices), std::move(values)),
+                                    description);
+                        break;
+                    case SparseFormat::CSR:
+                        storeSparse(name, SparseTensor::fromCSR(dims[0], dims[1], std::move(rowPtr),
+                                                                std::move(colIndices), std::move(values)),
+                                    description);
+                        break;
+                    case SparseFormat::BSR:
+                        storeSparse(name, SparseTensor::fromBSR(dims[0], dims[1], dims[2], std::move(rowPtr),
+                                                                std::move(colIndices), std::move(values)),
+                                    description);
+                        break;
+                    default:
+                        return false;
+                }
+            } catch (const std::invalid_argument&) {
+                return false;
+            }
+            continue;
+        }
+
         // Shape
         size_t rank;
         file.read(reinterpret_cast<char*>(&rank), sizeof(rank));
+        if (!file || rank > Tensor::Shape::MAX_RANK) return false;
         Tensor::Shape shape(rank);
+        size_t elements = 1;
         for (size_t j = 0; j < rank; ++j) {
             file.read(reinterpret_cast<char*>(&shape[j]), sizeof(size_t));
+            if (shape[j] == 0 || elements > SIZE_MAX / shape[j]) return false;
+            elements *= shape[j];
         }
 
-        // Daten
-        size_t dataSize;
-        file.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
-        std::vector<Tensor::DataType> data(dataSize);
-        file.read(reinterpret_cast<char*>(data.data()),
-                  dataSize * sizeof(Tensor::DataType));
+        uint8_t dtype = static_cast<uint8_t>(DType::Float32);
+        if (typed) file.read(reinterpret_cast<char*>(&dtype), sizeof(dtype));
+        if (dtype > static_cast<uint8_t>(DType::Int8)) return false;
+        const size_t item = dtypeSize(static_cast<DType>(dtype));
 
-        Tensor tensor(shape, data);
+        // Daten; Länge muss zur Shape passen, sonst liest fromBytes darüber hinaus
+        size_t dataSize = readLength(file, item);
+        if (!file || dataSize != elements) return false;
+        std::vector<char> bytes(dataSize * item);
+        file.read(bytes.data(), bytes.size());
+        if (!file) return false;
+
+        Tensor tensor = Tensor::fromBytes(shape, static_cast<DType>(dtype), bytes.data());
         store(name, tensor, description);
     }
 
@@ -293,15 +506,21 @@ bool TensorDB::loadFromFile(const std::string& filename) {
 
 TensorDB::DBStats TensorDB::getStats() const {
     DBStats stats;
-    stats.tensorCount = tensors_.size();
+    stats.tensorCount = count();
+    stats.sparseCount = sparse_.size();
     stats.totalElements = 0;
     stats.totalMemoryBytes = 0;
 
     for (const auto& [_, entry] : tensors_) {
         stats.totalElements += entry.tensor.size();
-        stats.totalMemoryBytes += entry.tensor.size() * sizeof(Tensor::DataType);
+        stats.totalMemoryBytes += entry.tensor.nbytes();
         stats.rankDistribution[entry.tensor.rank()]++;
     }
+    for (const auto& [_, entry] : sparse_) {
+        stats.totalElements += entry.tensor.rows() * entry.tensor.cols();
+        stats.totalMemoryBytes += entry.tensor.nbytes();
+        stats.rankDistribution[2]++;
+    }
 
     return stats;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "tensor/Sparse.hpp"
 #include "tensor/Tensor.hpp"
 #include <map>
 #include <optional>
@@ -16,6 +17,9 @@ struct TensorMetadata {
     std::string description;
     Tensor::Shape shape;
     size_t size;
+    DType dtype = DType::Float32;
+    bool sparse = false;
+    size_t nnz = 0;  // gespeicherte Werte bei sparse
     std::chrono::system_clock::time_point created;
     std::chrono::system_clock::time_point modified;
     std::map<std::string, std::string> tags;
@@ -30,6 +34,10 @@ struct TensorMetadata {
  *
  * Speichert Tensoren mit Namen und Metadaten.
  * Unterstützt grundlegende CRUD-Operationen und Abfragen.
+ *
+ * Dünn besetzte Matrizen (SparseTensor) teilen sich den Namensraum mit
+ * den dichten Tensoren, werden aber - auch in der Datei - nur mit ihren
+ * Nicht-Null-Werten abgelegt. get() liefert sie bei Bedarf dicht.
  */
 class TensorDB {
 public:
@@ -41,11 +49,19 @@ public:
     void store(const std::string& name, const Tensor& tensor,
                const std::string& description = "");
 
-    // Tensor abrufen
+    // Tensor abrufen (sparse Einträge werden dafür dicht ausgepackt)
     std::optional<Tensor> get(const std::string& name) const;
+    // Nur dichte Einträge
     Tensor& getRef(const std::string& name);
     const Tensor& getRef(const std::string& name) const;
 
+    // Dünn besetzte Matrix speichern bzw. abrufen; ersetzt einen
+    // gleichnamigen dichten Eintrag und umgekehrt
+    void storeSparse(const std::string& name, const SparseTensor& tensor,
+                     const std::string& description = "");
+    std::optional<SparseTensor> getSparse(const std::string& name) const;
+    bool isSparse(const std::string& name) const;
+
     // Tensor aktualisieren
     bool update(const std::string& name, const Tensor& tensor);
 
@@ -59,7 +75,7 @@ public:
     std::vector<std::string> listNames() const;
 
     // Anzahl der Tensoren
-    size_t count() const { return tensors_.size(); }
+    size_t count() const { return tensors_.size() + sparse_.size(); }
 
     // Datenbank leeren
     void clear();
@@ -88,6 +104,10 @@ public:
                  const std::string& a, const std::string& b,
                  const std::string& operation);
 
+    // Stapelt gespeicherte Tensoren gleicher Shape zu einem Batch (neue
+    // Achse axis); nullopt, wenn ein Name fehlt
+    std::optional<Tensor> batch(const std::vector<std::string>& names, size_t axis = 0) const;
+
     // Anwenden einer Funktion
     bool apply(const std::string& name, std::function<void(Tensor&)> func);
 
@@ -100,14 +120,15 @@ public:
 
     struct DBStats {
         size_t tensorCount;
-        size_t totalElements;
-        size_t totalMemoryBytes;
+        size_t sparseCount;
+        size_t totalElements;     // logische Elemente, auch bei sparse
+        size_t totalMemoryBytes;  // tatsächlich belegt
         std::map<size_t, size_t> rankDistribution;
     };
 
     DBStats getStats() const;
 
-    // === Iterator-Unterstützung ===
+    // === Iterator-Unterstützung (nur dichte Tensoren) ===
 
     auto begin() { return tensors_.begin(); }
     auto end() { return tensors_.end(); }
@@ -120,7 +141,16 @@ private:
         TensorMetadata metadata;
     };
 
+    struct SparseEntry {
+        SparseTensor tensor;
+        TensorMetadata metadata;
+    };
+
+    TensorMetadata* findMetadata(const std::string& name);
+    const TensorMetadata* findMetadata(const std::string& name) const;
+
     std::map<std::string, TensorEntry> tensors_;
+    std::map<std::string, SparseEntry> sparse_;
 };
 
 } // namespace tensor
@@ -0,0 +1,780 @@
+#pragma once
+
+// Wird am Ende von Tensor.hpp eingebunden, nicht direkt verwenden
+
+#include "tensor/NdIterator.hpp"
+#include "tensor/Scheduler.hpp"
+#include "tensor/VectorMath.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace tensor {
+namespace expr {
+
+using DataType = Tensor::DataType;
+
+struct ExprTag {};
+
+// === Operationen ===
+
+// keepsIntegers: Ganzzahl-Operanden ergeben wieder Ganzzahlen,
+// sonst ist das Ergebnis Gleitkomma (siehe floatingType)
+
+struct AddOp {
+    static constexpr bool keepsIntegers = true;
+    static constexpr const char* name = "addition";
+    DataType operator()(DataType x, DataType y) const { return x + y; }
+};
+
+struct SubOp {
+    static constexpr bool keepsIntegers = true;
+    static constexpr const char* name = "subtraction";
+    DataType operator()(DataType x, DataType y) const { return x - y; }
+};
+
+struct MulOp {
+    static constexpr bool keepsIntegers = true;
+    static constexpr const char* name = "multiplication";
+    DataType operator()(DataType x, DataType y) const { return x * y; }
+};
+
+struct DivOp {
+    static constexpr bool keepsIntegers = false;
+    static constexpr const char* name = "division";
+    DataType operator()(DataType x, DataType y) const { return x / y; }
+};
+
+// Unäre Operationen bearbeiten ganze Blöcke; out darf gleich in sein
+struct NegOp {
+    static constexpr bool keepsIntegers = true;
+    void operator()(const DataType* in, DataType* out, size_t n) const {
+        for (size_t i = 0; i < n; ++i) out[i] = -in[i];
+    }
+};
+
+struct AbsOp {
+    static constexpr bool keepsIntegers = true;
+    void operator()(const DataType* in, DataType* out, size_t n) const {
+        for (size_t i = 0; i < n; ++i) out[i] = std::fabs(in[i]);
+    }
+};
+
+struct SqrtOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::sqrt(in, out, n); }
+};
+
+struct ExpOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::exp(in, out, n); }
+};
+
+struct LogOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::log(in, out, n); }
+};
+
+struct SinOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::sin(in, out, n); }
+};
+
+struct CosOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::cos(in, out, n); }
+};
+
+// NaN bleibt NaN (wie max(0, x) in PyTorch)
+struct ReluOp {
+    static constexpr bool keepsIntegers = true;
+    void operator()(const DataType* in, DataType* out, size_t n) const {
+        for (size_t i = 0; i < n; ++i) out[i] = in[i] < 0.0f ? 0.0f : in[i];
+    }
+};
+
+struct SigmoidOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::sigmoid(in, out, n); }
+};
+
+struct TanhOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::tanh(in, out, n); }
+};
+
+struct GeluOp {
+    static constexpr bool keepsIntegers = false;
+    void operator()(const DataType* in, DataType* out, size_t n) const { vmath::gelu(in, out, n); }
+};
+
+struct PowOp {
+    static constexpr bool keepsIntegers = false;
+    DataType exponent;
+    void operator()(const DataType* in, DataType* out, size_t n) const {
+        vmath::pow(in, out, n, exponent);
+    }
+};
+
+// Beliebige Funktion pro Element (apply)
+template <typename F>
+struct MapOp {
+    static constexpr bool keepsIntegers = true;
+    F func;
+    void operator()(const DataType* in, DataType* out, size_t n) const {
+        for (size_t i = 0; i < n; ++i) out[i] = func(in[i]);
+    }
+};
+
+// Ausdrücke werden blockweise ausgewertet: klein genug für den L1-Cache,
+// groß genug, damit die Kernel vektorisiert durchlaufen
+constexpr size_t BLOCK = 256;
+
+template <typename Op, typename E> class Unary;
+
+/**
+ * @brief Basis aller lazy ausgewerteten elementweisen Ausdrücke
+ *
+ * Ein Ausdruck wie (a * 2.0f + b) / c baut nur einen Baum aus kleinen
+ * Knoten auf. Erst die Zuweisung an einen Tensor wertet ihn in einer
+ * einzigen Schleife direkt in den Zielpuffer aus - ohne Zwischentensoren.
+ *
+ * Jeder Knoten liefert mit block(i, n, buf) die Elemente [i, i + n):
+ * entweder als Zeiger in eigene Daten oder in buf geschrieben. So laufen
+ * die vektorisierten Kernel auf Blöcken statt auf Einzelwerten; reine
+ * Arithmetik (pointwise) bleibt dabei ohne Zwischenpuffer.
+ *
+ * Blätter halten ihren Tensor als geteilte Kopie; ein Ausdruck bleibt
+ * daher gültig, auch wenn die Operanden den Gültigkeitsbereich verlassen.
+ *
+ * Gerechnet wird in float32. dtype() ist der Typ des Ergebnisses nach den
+ * Promotionsregeln aus DType.hpp; erst beim Schreiben wird umgewandelt.
+ */
+template <typename Derived>
+class Expr : public ExprTag {
+public:
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+
+    size_t size() const {
+        size_t n = 1;
+        for (size_t d : self().shape()) n *= d;
+        return n;
+    }
+    size_t rank() const { return self().shape().size(); }
+
+    // Ausdruck in einen neuen Tensor auswerten
+    Tensor eval() const { return Tensor(*this); }
+
+    // Verkettbare elementweise Funktionen
+    Unary<NegOp, Derived> operator-() const { return {self(), NegOp{}}; }
+    Unary<SqrtOp, Derived> sqrt() const { return {self(), SqrtOp{}}; }
+    Unary<PowOp, Derived> pow(DataType exponent) const { return {self(), PowOp{exponent}}; }
+    Unary<ExpOp, Derived> exp() const { return {self(), ExpOp{}}; }
+    Unary<LogOp, Derived> log() const { return {self(), LogOp{}}; }
+    Unary<AbsOp, Derived> abs() const { return {self(), AbsOp{}}; }
+    Unary<SinOp, Derived> sin() const { return {self(), SinOp{}}; }
+    Unary<CosOp, Derived> cos() const { return {self(), CosOp{}}; }
+    Unary<ReluOp, Derived> relu() const { return {self(), ReluOp{}}; }
+    Unary<SigmoidOp, Derived> sigmoid() const { return {self(), SigmoidOp{}}; }
+    Unary<TanhOp, Derived> tanh() const { return {self(), TanhOp{}}; }
+    Unary<GeluOp, Derived> gelu() const { return {self(), GeluOp{}}; }
+
+    // Reduktionen direkt über den Ausdruck, ohne Zwischentensor
+    DataType sum() const;
+    DataType mean() const { return sum() / static_cast<DataType>(size()); }
+    DataType min() const;
+    DataType max() const;
+};
+
+// === Knoten ===
+
+// Blatt: Tensor oder View (auch gebroadcastet), wird nicht kopiert.
+// Andere Typen als float32 werden blockweise beim Lesen umgewandelt.
+class Leaf : public Expr<Leaf> {
+public:
+    static constexpr bool hasShape = true;
+    static constexpr bool pointwise = true;
+
+    explicit Leaf(const Tensor& t) : tensor_(t), dtype_(t.dtype()) { init(); }
+
+    // Temporärer Tensor: wird übernommen, sein Puffer ist wiederverwendbar
+    explicit Leaf(Tensor&& t) : tensor_(std::move(t)), dtype_(tensor_.dtype()) { init(); }
+
+    const Tensor::Shape& shape() const { return tensor_.shape(); }
+    DType dtype() const { return dtype_; }
+
+    // Zusammenhängend: Elemente direkt per at() bzw. als Zeiger lesbar
+    bool direct() const { return mode_ == Mode::Contiguous; }
+    DataType at(size_t i) const { return data_[i]; }
+
+    const DataType* block(size_t i, size_t n, DataType* buf) const {
+        switch (mode_) {
+            case Mode::Contiguous:
+                return data_ + i;
+            case Mode::Periodic:
+                return periodicBlock(i, n, buf);
+            case Mode::Converted:
+                convert(raw_ + i * dtypeSize(dtype_), dtype_, buf, DType::Float32, n);
+                return buf;
+            default:
+                return stridedBlock(i, n, buf);
+        }
+    }
+
+    // Broadcast auf shape (Stride 0 für gestreckte Achsen)
+    void expandTo(const Tensor::Shape& shape) {
+        // Vor dem Strecken umwandeln, solange der Tensor noch klein ist
+        if (tensor_.dtype() != DType::Float32) tensor_ = tensor_.to(DType::Float32);
+        tensor_ = tensor_.expand(shape);
+        init();
+    }
+
+    template <typename F>
+    void forEachLeaf(F&& f) const { f(*this); }
+
+    // Gehört der zusammenhängende Puffer allein diesem Blatt?
+    bool expiring() const {
+        return direct() && tensor_.storage_ && tensor_.storage_.use_count() == 1 &&
+               tensor_.storage_->writable();
+    }
+    const Tensor& tensor() const { return tensor_; }
+
+    // Liest das Blatt exakt die Elemente von t (gleicher Puffer, gleiche Sicht)?
+    bool sameView(const Tensor& t) const {
+        return direct() && t.isContiguous() && t.storage_ == tensor_.storage_ &&
+               t.offset_ == tensor_.offset_ && t.shape() == tensor_.shape();
+    }
+    bool sharesStorage(const Tensor& t) const { return t.sharesStorage(tensor_); }
+
+private:
+    // Periodic: führende Achsen mit Stride 0, dahinter zusammenhängend
+    // (Zeilenvektor über Matrix, Skalar-Tensor, passende hintere Achsen)
+    // Converted: zusammenhängend in anderem Typ, Umwandlung pro Block
+    enum class Mode { Contiguous, Periodic, Strided, Converted };
+
+    void init() {
+        if (tensor_.dtype() != DType::Float32) {
+            if (tensor_.isContiguous()) {
+                mode_ = Mode::Converted;
+                raw_ = tensor_.rawBase();
+                return;
+            }
+            tensor_ = tensor_.to(DType::Float32);
+        }
+        data_ = tensor_.storage_ ? tensor_.base() : nullptr;
+        if (tensor_.isContiguous()) {
+            mode_ = Mode::Contiguous;
+            return;
+        }
+
+        const Tensor::Shape& shape = tensor_.shape_;
+        const Tensor::Strides& strides = tensor_.strides_;
+        size_t k = shape.size();
+        size_t expected = 1;
+        while (k > 0 && (shape[k - 1] == 1 || strides[k - 1] == expected)) {
+            expected *= shape[k - 1];
+            --k;
+        }
+        for (size_t d = 0; d < k; ++d) {
+            if (shape[d] != 1 && strides[d] != 0) {
+                mode_ = Mode::Strided;
+                return;
+            }
+        }
+        mode_ = Mode::Periodic;
+        period_ = expected;
+    }
+
+    const DataType* periodicBlock(size_t i, size_t n, DataType* buf) const {
+        size_t j = i % period_;
+        if (j + n <= period_) return data_ + j;
+        if (period_ == 1) {
+            std::fill(buf, buf + n, data_[0]);
+            return buf;
+        }
+        for (size_t k = 0; k < n;) {
+            size_t len = std::min(n - k, period_ - j);
+            std::memcpy(buf + k, data_ + j, len * sizeof(DataType));
+            k += len;
+            j = 0;
+        }
+        return buf;
+    }
+
+    // Allgemeiner Fall: Zeilen der innersten Achse, äußere Achsen per Zähler
+    const DataType* stridedBlock(size_t i, size_t n, DataType* buf) const {
+        const Tensor::Shape& shape = tensor_.shape_;
+        const Tensor::Strides& strides = tensor_.strides_;
+        size_t r = shape.size();
+        size_t inner = shape[r - 1];
+        size_t innerStride = strides[r - 1];
+
+        Tensor::Shape outer(shape.begin(), shape.end() - 1);
+        NdIterator<1> row(outer, {strides}, i / inner);
+        for (size_t k = 0, j = i % inner; k < n; j = 0, row.next()) {
+            size_t len = std::min(n - k, inner - j);
+            const DataType* src = data_ + row.offset() + j * innerStride;
+            if (innerStride == 0) {
+                std::fill(buf + k, buf + k + len, *src);
+            } else if (innerStride == 1) {
+                std::memcpy(buf + k, src, len * sizeof(DataType));
+            } else {
+                for (size_t x = 0; x < len; ++x) buf[k + x] = src[x * innerStride];
+            }
+            k += len;
+        }
+        return buf;
+    }
+
+    Tensor tensor_;
+    DType dtype_;
+    const DataType* data_ = nullptr;
+    const char* raw_ = nullptr;
+    Mode mode_ = Mode::Contiguous;
+    size_t period_ = 1;
+};
+
+// Skalar: passt sich an jede Shape an
+class Scalar {
+public:
+    static constexpr bool hasShape = false;
+    static constexpr bool pointwise = true;
+
+    explicit Scalar(DataType value) : value_(value) {}
+    DataType value() const { return value_; }
+    bool direct() const { return true; }
+    DataType at(size_t) const { return value_; }
+    const DataType* block(size_t, size_t n, DataType* buf) const {
+        std::fill(buf, buf + n, value_);
+        return buf;
+    }
+    void expandTo(const Tensor::Shape&) {}
+
+    template <typename F>
+    void forEachLeaf(F&&) const {}
+
+private:
+    DataType value_;
+};
+
+template <typename Op, typename E>
+class Unary : public Expr<Unary<Op, E>> {
+public:
+    static constexpr bool hasShape = true;
+    static constexpr bool pointwise = false;
+
+    Unary(E e, Op op) : e_(std::move(e)), op_(std::move(op)) {}
+
+    const Tensor::Shape& shape() const { return e_.shape(); }
+    DType dtype() const { return Op::keepsIntegers ? e_.dtype() : floatingType(e_.dtype()); }
+    bool direct() const { return false; }
+
+    const DataType* block(size_t i, size_t n, DataType* buf) const {
+        op_(e_.block(i, n, buf), buf, n);
+        return buf;
+    }
+
+    // Broadcasting vertauscht mit elementweisen Funktionen
+    void expandTo(const Tensor::Shape& shape) { e_.expandTo(shape); }
+
+    template <typename F>
+    void forEachLeaf(F&& f) const { e_.forEachLeaf(f); }
+
+private:
+    E e_;
+    Op op_;
+};
+
+template <typename Op, typename L, typename R>
+class Binary : public Expr<Binary<Op, L, R>> {
+public:
+    static constexpr bool hasShape = true;
+    // Reine Arithmetik auf Blättern wird pro Element in Registern verknüpft
+    static constexpr bool pointwise = L::pointwise && R::pointwise;
+
+    Binary(L l, R r) : l_(std::move(l)), r_(std::move(r)) {
+        if constexpr (L::hasShape && R::hasShape) {
+            if (l_.shape() != r_.shape()) {
+                Tensor::Shape shape = Tensor::broadcastShapes(l_.shape(), r_.shape());
+                if (l_.shape() != shape) l_.expandTo(shape);
+                if (r_.shape() != shape) r_.expandTo(shape);
+            }
+        }
+        direct_ = l_.direct() && r_.direct();
+    }
+
+    const Tensor::Shape& shape() const {
+        if constexpr (L::hasShape) {
+            return l_.shape();
+        } else {
+            return r_.shape();
+        }
+    }
+
+    DType dtype() const {
+        DType t;
+        if constexpr (!L::hasShape) {
+            t = promoteScalar(r_.dtype(), l_.value());
+        } else if constexpr (!R::hasShape) {
+            t = promoteScalar(l_.dtype(), r_.value());
+        } else {
+            t = promoteTypes(l_.dtype(), r_.dtype());
+        }
+        return Op::keepsIntegers ? t : floatingType(t);
+    }
+
+    bool direct() const { return direct_; }
+    DataType at(size_t i) const { return Op()(l_.at(i), r_.at(i)); }
+
+    void expandTo(const Tensor::Shape& shape) {
+        l_.expandTo(shape);
+        r_.expandTo(shape);
+        direct_ = l_.direct() && r_.direct();
+    }
+
+    const DataType* block(size_t i, size_t n, DataType* buf) const {
+        Op op;
+        if constexpr (pointwise) {
+            if (direct_) {
+                for (size_t k = 0; k < n; ++k) buf[k] = at(i + k);
+                return buf;
+            }
+        }
+        if constexpr (!L::hasShape) {
+            const DataType s = l_.value();
+            const DataType* y = r_.block(i, n, buf);
+            for (size_t k = 0; k < n; ++k) buf[k] = op(s, y[k]);
+        } else if constexpr (!R::hasShape) {
+            const DataType s = r_.value();
+            const DataType* x = l_.block(i, n, buf);
+            for (size_t k = 0; k < n; ++k) buf[k] = op(x[k], s);
+        } else {
+            alignas(64) DataType tmp[BLOCK];
+            const DataType* x = l_.block(i, n, buf);
+            const DataType* y = r_.block(i, n, tmp);
+            for (size_t k = 0; k < n; ++k) buf[k] = op(x[k], y[k]);
+        }
+        return buf;
+    }
+
+    template <typename F>
+    void forEachLeaf(F&& f) const {
+        l_.forEachLeaf(f);
+        r_.forEachLeaf(f);
+    }
+
+private:
+    L l_;
+    R r_;
+    // Alle Blätter zusammenhängend: at() statt Blockpuffer
+    bool direct_ = false;
+};
+
+// === Auswertung ===
+
+// Schreibt den Ausdruck blockweise nach out, ab der Serial-Schwelle parallel.
+// aliased: out ist zugleich Eingabe, jeder Block wird erst komplett berechnet.
+template <typename E>
+void evaluate(const E& e, DataType* out, size_t n, bool aliased = false) {
+    parallel_for(0, n, 0, [&e, out, aliased](size_t begin, size_t end) {
+        alignas(64) DataType buf[BLOCK];
+        for (size_t i = begin; i < end; i += BLOCK) {
+            size_t len = std::min(BLOCK, end - i);
+            DataType* dst = aliased ? buf : out + i;
+            const DataType* src = e.block(i, len, dst);
+            if (src != out + i) std::memcpy(out + i, src, len * sizeof(DataType));
+        }
+    });
+}
+
+// Wie evaluate, aber out hat den Typ dtype: blockweise rechnen, dann umwandeln
+template <typename E>
+void evaluateAs(const E& e, void* out, DType dtype, size_t n, bool aliased = false) {
+    if (dtype == DType::Float32) {
+        evaluate(e, static_cast<DataType*>(out), n, aliased);
+        return;
+    }
+    char* dst = static_cast<char*>(out);
+    size_t item = dtypeSize(dtype);
+    parallel_for(0, n, 0, [&e, dst, dtype, item](size_t begin, size_t end) {
+        alignas(64) DataType buf[BLOCK];
+        for (size_t i = begin; i < end; i += BLOCK) {
+            size_t len = std::min(BLOCK, end - i);
+            convert(e.block(i, len, buf), DType::Float32, dst + i * item, dtype, len);
+        }
+    });
+}
+
+// out = out op e, blockweise
+template <typename Op, typename E>
+void evaluateCompound(const E& e, DataType* out, size_t n) {
+    parallel_for(0, n, 0, [&e, out](size_t begin, size_t end) {
+        Op op;
+        alignas(64) DataType buf[BLOCK];
+        for (size_t i = begin; i < end; i += BLOCK) {
+            size_t len = std::min(BLOCK, end - i);
+            DataType* dst = out + i;
+            if constexpr (E::pointwise) {
+                if (e.direct()) {
+                    for (size_t k = 0; k < len; ++k) dst[k] = op(dst[k], e.at(i + k));
+                    continue;
+                }
+            }
+            const DataType* y = e.block(i, len, buf);
+            for (size_t k = 0; k < len; ++k) dst[k] = op(dst[k], y[k]);
+        }
+    });
+}
+
+// Wie evaluateCompound für einen Puffer vom Typ dtype (nicht float32)
+template <typename Op, typename E>
+void evaluateCompoundAs(const E& e, void* out, DType dtype, size_t n) {
+    char* dst = static_cast<char*>(out);
+    size_t item = dtypeSize(dtype);
+    parallel_for(0, n, 0, [&e, dst, dtype, item](size_t begin, size_t end) {
+        Op op;
+        alignas(64) DataType acc[BLOCK];
+        alignas(64) DataType buf[BLOCK];
+        for (size_t i = begin; i < end; i += BLOCK) {
+            size_t len = std::min(BLOCK, end - i);
+            convert(dst + i * item, dtype, acc, DType::Float32, len);
+            const DataType* y = e.block(i, len, buf);
+            for (size_t k = 0; k < len; ++k) acc[k] = op(acc[k], y[k]);
+            convert(acc, DType::Float32, dst + i * item, dtype, len);
+        }
+    });
+}
+
+// Faltet den Ausdruck blockweise mit fold(acc, block, n)
+template <typename E, typename Fold, typename Combine>
+DataType reduce(const E& e, size_t n, DataType identity, Fold fold, Combine combine) {
+    return parallel_reduce(size_t(0), n, 0, identity,
+        [&](size_t begin, size_t end) {
+            alignas(64) DataType buf[BLOCK];
+            DataType acc = identity;
+            for (size_t i = begin; i < end; i += BLOCK) {
+                size_t len = std::min(BLOCK, end - i);
+                acc = fold(acc, e.block(i, len, buf), len);
+            }
+            return acc;
+        },
+        combine);
+}
+
+template <typename Derived>
+DataType Expr<Derived>::sum() const {
+    return reduce(self(), size(), DataType(0),
+        [](DataType acc, const DataType* x, size_t n) {
+            for (size_t i = 0; i < n; ++i) acc += x[i];
+            return acc;
+        },
+        std::plus<DataType>());
+}
+
+template <typename Derived>
+DataType Expr<Derived>::min() const {
+    return reduce(self(), size(), std::numeric_limits<DataType>::max(),
+        [](DataType acc, const DataType* x, size_t n) {
+            for (size_t i = 0; i < n; ++i) acc = std::min(acc, x[i]);
+            return acc;
+        },
+        [](DataType a, DataType b) { return std::min(a, b); });
+}
+
+template <typename Derived>
+DataType Expr<Derived>::max() const {
+    return reduce(self(), size(), std::numeric_limits<DataType>::lowest(),
+        [](DataType acc, const DataType* x, size_t n) {
+            for (size_t i = 0; i < n; ++i) acc = std::max(acc, x[i]);
+            return acc;
+        },
+        [](DataType a, DataType b) { return std::max(a, b); });
+}
+
+// === Operanden ===
+
+// Tensor oder Ausdruck
+template <typename T>
+constexpr bool isOperand = std::is_same_v<std::decay_t<T>, Tensor> ||
+                           std::is_base_of_v<ExprTag, std::decay_t<T>>;
+
+inline Leaf node(const Tensor& t) { return Leaf(t); }
+inline Leaf node(Tensor&& t) { return Leaf(std::move(t)); }
+
+template <typename D>
+const D& node(const Expr<D>& e) { return e.self(); }
+
+template <typename D>
+D node(Expr<D>&& e) { return std::move(static_cast<D&>(e)); }
+
+template <typename T>
+using NodeType = std::decay_t<decltype(node(std::declval<T>()))>;
+
+template <typename Op, typename L, typename R>
+Binary<Op, NodeType<L>, NodeType<R>> makeBinary(L&& l, R&& r) {
+    return {node(std::forward<L>(l)), node(std::forward<R>(r))};
+}
+
+template <typename Op, typename L>
+Binary<Op, NodeType<L>, Scalar> makeBinary(L&& l, DataType s) {
+    return {node(std::forward<L>(l)), Scalar(s)};
+}
+
+template <typename Op, typename R>
+Binary<Op, Scalar, NodeType<R>> makeBinary(DataType s, R&& r) {
+    return {Scalar(s), node(std::forward<R>(r))};
+}
+
+} // namespace expr
+
+// === Tensor-Anbindung ===
+
+template <typename E>
+Tensor::Tensor(const expr::Expr<E>& e)
+    : Tensor(uninitialized(e.self().shape(), e.self().dtype())) {
+    expr::evaluateAs(e.self(), rawBase(), dtype(), size_);
+}
+
+template <typename E>
+Tensor::Tensor(expr::Expr<E>&& e) {
+    // Ein Blatt, das nur noch im Ausdruck lebt, wird zum Ergebnis
+    // (Blätter sind float32, also nur bei float32-Ergebnis)
+    const Shape& shape = e.self().shape();
+    DType type = e.self().dtype();
+    const expr::Leaf* reuse = nullptr;
+    if (type == DType::Float32) {
+        e.self().forEachLeaf([&](const expr::Leaf& leaf) {
+            if (!reuse && leaf.expiring() && leaf.shape() == shape) reuse = &leaf;
+        });
+    }
+
+    if (reuse) {
+        *this = reuse->tensor();
+        markModified();
+        expr::evaluate(e.self(), base(), size_, true);
+    } else {
+        *this = uninitialized(shape, type);
+        expr::evaluateAs(e.self(), rawBase(), type, size_);
+    }
+}
+
+template <typename E>
+Tensor& Tensor::operator=(const expr::Expr<E>& e) {
+    // Erst auswerten, dann übernehmen: der Ausdruck darf *this enthalten
+    *this = Tensor(e);
+    return *this;
+}
+
+template <typename E>
+Tensor& Tensor::operator=(expr::Expr<E>&& e) {
+    *this = Tensor(std::move(e));
+    return *this;
+}
+
+template <typename Op, typename E>
+Tensor& Tensor::compoundAssign(E e) {
+    if constexpr (E::hasShape) {
+        if (shape_ != e.shape()) {
+            // Nur die rechte Seite darf gestreckt werden
+            if (broadcastShapes(shape_, e.shape()) != shape_) {
+                throw std::invalid_argument(std::string("Shape mismatch for ") + Op::name);
+            }
+            e.expandTo(shape_);
+        }
+    }
+    if (size_ == 0) return *this;
+
+    // Ohne Kopie nur, wenn alle übrigen Besitzer Blätter mit exakt dieser Sicht sind
+    long sameView = 0;
+    bool foreignView = false;
+    e.forEachLeaf([&](const expr::Leaf& leaf) {
+        if (leaf.sameView(*this)) {
+            ++sameView;
+        } else if (leaf.sharesStorage(*this)) {
+            foreignView = true;
+        }
+    });
+    if (foreignView || !ownsStorage(1 + sameView)) {
+        detach();
+    } else {
+        markModified();
+    }
+
+    // Der Typ von *this bleibt, auch wenn e einen größeren hätte
+    if (dtype() == DType::Float32) {
+        expr::evaluateCompound<Op>(e, base(), size_);
+    } else {
+        expr::evaluateCompoundAs<Op>(e, rawBase(), dtype(), size_);
+    }
+    return *this;
+}
+
+template <typename E>
+Tensor& Tensor::operator+=(const expr::Expr<E>& e) { return compoundAssign<expr::AddOp>(e.self()); }
+template <typename E>
+Tensor& Tensor::operator-=(const expr::Expr<E>& e) { return compoundAssign<expr::SubOp>(e.self()); }
+template <typename E>
+Tensor& Tensor::operator*=(const expr::Expr<E>& e) { return compoundAssign<expr::MulOp>(e.self()); }
+template <typename E>
+Tensor& Tensor::operator/=(const expr::Expr<E>& e) { return compoundAssign<expr::DivOp>(e.self()); }
+
+template <typename F>
+Tensor Tensor::apply(F func) const {
+    return Tensor(expr::Unary<expr::MapOp<F>, expr::Leaf>(expr::Leaf(*this), {std::move(func)}));
+}
+
+template <typename F>
+Tensor Tensor::generate(const Shape& shape, F func) {
+    Tensor result = uninitialized(shape);
+    DataType* out = result.base();
+    parallel_for(0, result.size_, 0, [&func, out](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            out[i] = func(i);
+        }
+    });
+    return result;
+}
+
+inline auto Tensor::operator-() const { return expr::Leaf(*this).operator-(); }
+inline auto Tensor::sqrt() const { return expr::Leaf(*this).sqrt(); }
+inline auto Tensor::pow(DataType exponent) const { return expr::Leaf(*this).pow(exponent); }
+inline auto Tensor::exp() const { return expr::Leaf(*this).exp(); }
+inline auto Tensor::log() const { return expr::Leaf(*this).log(); }
+inline auto Tensor::abs() const { return expr::Leaf(*this).abs(); }
+inline auto Tensor::sin() const { return expr::Leaf(*this).sin(); }
+inline auto Tensor::cos() const { return expr::Leaf(*this).cos(); }
+inline auto Tensor::relu() const { return expr::Leaf(*this).relu(); }
+inline auto Tensor::sigmoid() const { return expr::Leaf(*this).sigmoid(); }
+inline auto Tensor::tanh() const { return expr::Leaf(*this).tanh(); }
+inline auto Tensor::gelu() const { return expr::Leaf(*this).gelu(); }
+
+// === Elementweise Operatoren ===
+
+// Rvalue-Tensoren werden in den Ausdruck verschoben (siehe Tensor(Expr&&))
+#define TENSOR_EXPR_OPERATOR(sym, Op)                                                   \
+    template <typename L, typename R,                                                   \
+              typename = std::enable_if_t<expr::isOperand<L> && expr::isOperand<R>>>    \
+    auto operator sym(L&& l, R&& r) {                                                   \
+        return expr::makeBinary<expr::Op>(std::forward<L>(l), std::forward<R>(r));      \
+    }                                                                                   \
+    template <typename L, typename = std::enable_if_t<expr::isOperand<L>>>              \
+    auto operator sym(L&& l, Tensor::DataType s) {                                      \
+        return expr::makeBinary<expr::Op>(std::forward<L>(l), s);                       \
+    }                                                                                   \
+    template <typename R, typename = std::enable_if_t<expr::isOperand<R>>>              \
+    auto operator sym(Tensor::DataType s, R&& r) {                                      \
+        return expr::makeBinary<expr::Op>(s, std::forward<R>(r));                       \
+    }
+
+TENSOR_EXPR_OPERATOR(+, AddOp)
+TENSOR_EXPR_OPERATOR(-, SubOp)
+TENSOR_EXPR_OPERATOR(*, MulOp)
+TENSOR_EXPR_OPERATOR(/, DivOp)
+
+#undef TENSOR_EXPR_OPERATOR
+
+} // namespace tensor
@@ -0,0 +1,356 @@
+#include "tensor/VectorMath.hpp"
+#include "tensor/Simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace tensor {
+namespace vmath {
+
+namespace {
+
+bool useAvx2() {
+    static const bool avx2 = simd::cpu().avx2 && simd::cpu().fma;
+    return avx2;
+}
+
+#if TENSOR_X86
+
+// === AVX2-Kernel (je 8 Elemente) ===
+
+TENSOR_TARGET("avx2,fma")
+inline __m256 expAvx(__m256 x) {
+    const __m256 hi = _mm256_set1_ps(88.7228f);
+    const __m256 lo = _mm256_set1_ps(-103.972f);
+
+    // Min/Max liefern bei NaN den zweiten Operanden; NaN wird am Ende zurückgesetzt
+    __m256 xc = _mm256_min_ps(_mm256_max_ps(x, lo), hi);
+
+    // x = n * ln2 + r mit |r| <= ln2 / 2
+    __m256 fx = _mm256_fmadd_ps(xc, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f));
+    fx = _mm256_floor_ps(fx);
+    __m256 r = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), xc);
+    r = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), r);
+
+    __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(1.3981999507e-3f));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(8.3334519073e-3f));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(4.1665795894e-2f));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(1.6666665459e-1f));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(5.0000001201e-1f));
+    y = _mm256_fmadd_ps(y, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+
+    // 2^n in zwei Faktoren, damit auch Ergebnisse im Denormal-Bereich stimmen
+    __m256i n = _mm256_cvtps_epi32(fx);
+    __m256i n1 = _mm256_srai_epi32(n, 1);
+    __m256i n2 = _mm256_sub_epi32(n, n1);
+    const __m256i bias = _mm256_set1_epi32(127);
+    __m256 s1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n1, bias), 23));
+    __m256 s2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n2, bias), 23));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, s1), s2);
+
+    y = _mm256_blendv_ps(y, _mm256_set1_ps(INFINITY), _mm256_cmp_ps(x, hi, _CMP_GT_OQ));
+    y = _mm256_blendv_ps(y, _mm256_setzero_ps(), _mm256_cmp_ps(x, lo, _CMP_LT_OQ));
+    return _mm256_blendv_ps(y, x, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+}
+
+TENSOR_TARGET("avx2,fma")
+inline __m256 logAvx(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    // Denormale Werte vorher mit 2^23 skalieren
+    __m256 denormal = _mm256_cmp_ps(x, _mm256_set1_ps(1.17549435e-38f), _CMP_LT_OQ);
+    __m256 xs = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(8388608.0f)), denormal);
+    __m256 eAdj = _mm256_and_ps(denormal, _mm256_set1_ps(23.0f));
+
+    // x = m * 2^e mit m in [0.5, 1)
+    __m256i bits = _mm256_castps_si256(xs);
+    __m256i ei = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126));
+    __m256 e = _mm256_sub_ps(_mm256_cvtepi32_ps(ei), eAdj);
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+        _mm256_castps_si256(_mm256_set1_ps(0.5f))));
+
+    // m < sqrt(1/2): m verdoppeln, e verringern -> m - 1 in [-0.29, 0.41]
+    __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(one, small));
+    m = _mm256_add_ps(_mm256_sub_ps(m, one), _mm256_and_ps(m, small));
+
+    __m256 z = _mm256_mul_ps(m, m);
+    __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-1.1514610310e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(1.1676998740e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-1.2420140846e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(1.4249322787e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-1.6668057665e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(2.0000714765e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(-2.4999993993e-1f));
+    y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(3.3333331174e-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, m), z);
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+    y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+    __m256 r = _mm256_add_ps(m, y);
+    r = _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), r);
+
+    // Sonderwerte: log(0) = -inf, log(inf) = inf, log(x < 0) = log(NaN) = NaN
+    r = _mm256_blendv_ps(r, _mm256_set1_ps(-INFINITY), _mm256_cmp_ps(x, zero, _CMP_EQ_OQ));
+    r = _mm256_blendv_ps(r, x, _mm256_cmp_ps(x, _mm256_set1_ps(INFINITY), _CMP_EQ_OQ));
+    return _mm256_blendv_ps(r, _mm256_set1_ps(NAN), _mm256_cmp_ps(x, zero, _CMP_NGE_UQ));
+}
+
+// Bis hier ist die Reduktion mit drei Konstanten genau genug
+constexpr float TRIG_LIMIT = 8192.0f;
+
+TENSOR_TARGET("avx2,fma")
+inline __m256 sinCosAvx(__m256 x, bool cosine) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 sign = cosine ? _mm256_setzero_ps() : _mm256_and_ps(x, signMask);
+    x = _mm256_andnot_ps(signMask, x);
+
+    // Oktant j (gerade gerundet) und Rest x - j * pi/4
+    __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f)));
+    j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+    __m256 y = _mm256_cvtepi32_ps(j);
+    if (cosine) {
+        j = _mm256_sub_epi32(j, _mm256_set1_epi32(2));
+        sign = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_andnot_si256(j, _mm256_set1_epi32(4)), 29));
+    } else {
+        sign = _mm256_xor_ps(sign, _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+    }
+    __m256 useSin = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+        _mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+
+    x = _mm256_fmadd_ps(y, _mm256_set1_ps(-0.78515625f), x);
+    x = _mm256_fmadd_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f), x);
+    x = _mm256_fmadd_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f), x);
+    __m256 z = _mm256_mul_ps(x, x);
+
+    __m256 c = _mm256_set1_ps(2.443315711809948e-5f);
+    c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(-1.388731625493765e-3f));
+    c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(4.166664568298827e-2f));
+    c = _mm256_mul_ps(_mm256_mul_ps(c, z), z);
+    c = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), c);
+    c = _mm256_add_ps(c, _mm256_set1_ps(1.0f));
+
+    __m256 s = _mm256_set1_ps(-1.9515295891e-4f);
+    s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(8.3321608736e-3f));
+    s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(-1.6666654611e-1f));
+    s = _mm256_fmadd_ps(_mm256_mul_ps(s, z), x, x);
+
+    return _mm256_xor_ps(_mm256_blendv_ps(c, s, useSin), sign);
+}
+
+// 1 / (1 + e^-x) über e = exp(-|x|), damit exp nie überläuft
+TENSOR_TARGET("avx2,fma")
+inline __m256 sigmoidAvx(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 e = expAvx(_mm256_or_ps(x, _mm256_set1_ps(-0.0f)));
+    __m256 r = _mm256_div_ps(one, _mm256_add_ps(one, e));
+    return _mm256_blendv_ps(_mm256_mul_ps(e, r), r, _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GE_OQ));
+}
+
+TENSOR_TARGET("avx2,fma")
+inline __m256 tanhAvx(__m256 x) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 ax = _mm256_andnot_ps(signMask, x);
+
+    // |x| >= 0.625: (1 - e) / (1 + e) mit e = exp(-2|x|)
+    __m256 e = expAvx(_mm256_mul_ps(ax, _mm256_set1_ps(-2.0f)));
+    __m256 large = _mm256_div_ps(_mm256_sub_ps(one, e), _mm256_add_ps(one, e));
+    large = _mm256_or_ps(large, _mm256_and_ps(x, signMask));
+
+    // Sonst Polynom (Cephes), vermeidet die Auslöschung in 1 - e
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(2.06390887954e-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-5.37397155531e-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.33314422036e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33332819422e-1f));
+    __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, z), x, x);
+
+    return _mm256_blendv_ps(large, small, _mm256_cmp_ps(ax, _mm256_set1_ps(0.625f), _CMP_LT_OQ));
+}
+
+TENSOR_TARGET("avx2,fma")
+inline __m256 geluAvx(__m256 x) {
+    __m256 x3 = _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+    __m256 u = _mm256_fmadd_ps(x3, _mm256_set1_ps(0.044715f), x);
+    return _mm256_mul_ps(x, sigmoidAvx(_mm256_mul_ps(u, _mm256_set1_ps(1.5957691216057308f))));
+}
+
+template <typename VecFn, typename ScalarFn>
+TENSOR_TARGET("avx2,fma")
+void mapAvx(const float* in, float* out, size_t n, VecFn vec, ScalarFn scalar) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, vec(_mm256_loadu_ps(in + i)));
+    }
+    for (; i < n; ++i) {
+        out[i] = scalar(in[i]);
+    }
+}
+
+// Lambdas erben das Zielattribut nicht, daher eigene Funktoren
+struct SqrtAvx {
+    TENSOR_TARGET("avx2,fma") __m256 operator()(__m256 x) const { return _mm256_sqrt_ps(x); }
+};
+struct ExpAvx {
+    TENSOR_TARGET("avx2,fma") __m256 operator()(__m256 x) const { return expAvx(x); }
+};
+struct LogAvx {
+    TENSOR_TARGET("avx2,fma") __m256 operator()(__m256 x) const { return logAvx(x); }
+};
+
+struct SigmoidAvx {
+    TENSOR_TARGET("avx2,fma") __m256 operator()(__m256 x) const { return sigmoidAvx(x); }
+};
+struct TanhAvx {
+    TENSOR_TARGET("avx2,fma") __m256 operator()(__m256 x) const { return tanhAvx(x); }
+};
+struct GeluAvx {
+    TENSOR_TARGET("avx2,fma") __m256 operator()(__m256 x) const { return geluAvx(x); }
+};
+
+template <bool Cosine>
+struct TrigAvx {
+    TENSOR_TARGET("avx2,fma") __m256 operator()(__m256 x) const { return sinCosAvx(x, Cosine); }
+};
+
+// sin/cos: Vektoren mit großen oder nicht-endlichen Werten gehen an std::
+template <bool Cosine, typename ScalarFn>
+TENSOR_TARGET("avx2,fma")
+void trigAvx(const float* in, float* out, size_t n, ScalarFn scalar) {
+    const __m256 limit = _mm256_set1_ps(TRIG_LIMIT);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i);
+        __m256 tooLarge = _mm256_cmp_ps(_mm256_andnot_ps(signMask, x), limit, _CMP_NLE_UQ);
+        if (_mm256_movemask_ps(tooLarge) == 0) {
+            _mm256_storeu_ps(out + i, sinCosAvx(x, Cosine));
+        } else {
+            for (size_t k = i; k < i + 8; ++k) out[k] = scalar(in[k]);
+        }
+    }
+    for (; i < n; ++i) {
+        out[i] = scalar(in[i]);
+    }
+}
+
+#endif // TENSOR_X86
+
+float sigmoidScalar(float x) {
+    float e = std::exp(-std::fabs(x));
+    float r = 1.0f / (1.0f + e);
+    return x >= 0.0f ? r : e * r;
+}
+
+template <typename ScalarFn>
+void mapScalar(const float* in, float* out, size_t n, ScalarFn scalar) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = scalar(in[i]);
+    }
+}
+
+} // namespace
+
+void sqrt(const float* in, float* out, size_t n) {
+    auto scalar = [](float x) { return std::sqrt(x); };
+#if TENSOR_X86
+    if (useAvx2()) return mapAvx(in, out, n, SqrtAvx(), scalar);
+#endif
+    mapScalar(in, out, n, scalar);
+}
+
+void exp(const float* in, float* out, size_t n) {
+    auto scalar = [](float x) { return std::exp(x); };
+#if TENSOR_X86
+    if (useAvx2()) return mapAvx(in, out, n, ExpAvx(), scalar);
+#endif
+    mapScalar(in, out, n, scalar);
+}
+
+void log(const float* in, float* out, size_t n) {
+    auto scalar = [](float x) { return std::log(x); };
+#if TENSOR_X86
+    if (useAvx2()) return mapAvx(in, out, n, LogAvx(), scalar);
+#endif
+    mapScalar(in, out, n, scalar);
+}
+
+void sin(const float* in, float* out, size_t n) {
+    auto scalar = [](float x) { return std::sin(x); };
+#if TENSOR_X86
+    if (useAvx2()) return trigAvx<false>(in, out, n, scalar);
+#endif
+    mapScalar(in, out, n, scalar);
+}
+
+void cos(const float* in, float* out, size_t n) {
+    auto scalar = [](float x) { return std::cos(x); };
+#if TENSOR_X86
+    if (useAvx2()) return trigAvx<true>(in, out, n, scalar);
+#endif
+    mapScalar(in, out, n, scalar);
+}
+
+void sigmoid(const float* in, float* out, size_t n) {
+#if TENSOR_X86
+    if (useAvx2()) return mapAvx(in, out, n, SigmoidAvx(), sigmoidScalar);
+#endif
+    mapScalar(in, out, n, sigmoidScalar);
+}
+
+void tanh(const float* in, float* out, size_t n) {
+    auto scalar = [](float x) { return std::tanh(x); };
+#if TENSOR_X86
+    if (useAvx2()) return mapAvx(in, out, n, TanhAvx(), scalar);
+#endif
+    mapScalar(in, out, n, scalar);
+}
+
+void gelu(const float* in, float* out, size_t n) {
+    auto scalar = [](float x) {
+        return x * sigmoidScalar(1.5957691216057308f * (x + 0.044715f * x * x * x));
+    };
+#if TENSOR_X86
+    if (useAvx2()) return mapAvx(in, out, n, GeluAvx(), scalar);
+#endif
+    mapScalar(in, out, n, scalar);
+}
+
+void pow(const float* in, float* out, size_t n, float exponent) {
+    if (exponent == 2.0f) {
+        for (size_t i = 0; i < n; ++i) out[i] = in[i] * in[i];
+    } else if (exponent == 3.0f) {
+        for (size_t i = 0; i < n; ++i) out[i] = in[i] * in[i] * in[i];
+    } else if (exponent == 1.0f) {
+        for (size_t i = 0; i < n; ++i) out[i] = in[i];
+    } else if (exponent == 0.0f) {
+        for (size_t i = 0; i < n; ++i) out[i] = 1.0f;
+    } else if (exponent == -1.0f) {
+        for (size_t i = 0; i < n; ++i) out[i] = 1.0f / in[i];
+    } else if (exponent == 0.5f) {
+        // Wie std::pow: pow(-inf, 0.5) = +inf und pow(-0, 0.5) = +0, wo
+        // sqrt NaN bzw. -0 liefert (+ 0.0f macht aus -0 eine +0). -inf
+        // vorher merken: in und out dürfen derselbe Puffer sein.
+        constexpr size_t BLOCK = 256;
+        const float inf = std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < n; i += BLOCK) {
+            const size_t len = std::min(BLOCK, n - i);
+            bool negInf[BLOCK];
+            for (size_t j = 0; j < len; ++j) negInf[j] = in[i + j] == -inf;
+            sqrt(in + i, out + i, len);
+            for (size_t j = 0; j < len; ++j) out[i + j] = negInf[j] ? inf : out[i + j] + 0.0f;
+        }
+    } else {
+        mapScalar(in, out, n, [exponent](float x) { return std::pow(x, exponent); });
+    }
+}
+
+} // namespace vmath
+} // namespace tensor
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+namespace tensor {
+namespace vmath {
+
+/**
+ * @brief Vektorisierte elementweise Mathematik über Float-Arrays
+ *
+ * Jede Funktion berechnet out[i] = f(in[i]) für n Elemente. in und out
+ * dürfen identisch sein (in-place), sich aber nicht versetzt überlappen.
+ *
+ * Auf CPUs mit AVX2/FMA laufen exp, log, sin und cos über Polynomnäherungen
+ * (Cephes) mit wenigen ULP Abweichung zu std::; sqrt ist exakt. Sonderwerte
+ * (NaN, ±Inf, 0, negative Argumente bei log) verhalten sich wie in <cmath>.
+ */
+
+void sqrt(const float* in, float* out, size_t n);
+void exp(const float* in, float* out, size_t n);
+void log(const float* in, float* out, size_t n);
+void sin(const float* in, float* out, size_t n);
+void cos(const float* in, float* out, size_t n);
+
+// Aktivierungen, stabil für große |x| (kein Überlauf in exp)
+void sigmoid(const float* in, float* out, size_t n);
+void tanh(const float* in, float* out, size_t n);
+// GELU in der Tanh-Näherung: x * sigmoid(2 * sqrt(2/pi) * (x + 0.044715 x^3))
+void gelu(const float* in, float* out, size_t n);
+
+// Häufige Exponenten (0, ±1, 2, 3, 0.5) ohne std::pow
+void pow(const float* in, float* out, size_t n, float exponent);
+
+} // namespace vmath
+} // namespace tensor